@@ -1,1181 +1,11102 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <time.h>
-#include "windows.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
 
 using namespace std;
 
-#pragma region "Skup.h"
+#pragma region "Instrumentacija.h"
 
-class Skup
+/* opciono merenje rada svakog skupa: broj poziva i histogram kasnjenja za svaku javnu operaciju,
+broj poredjenja kljuceva, posecenih cvorova i alokacija. Ukljucuje se prevodjenjem sa
+-DINSTRUMENTACIJA; bez toga su makroi ispod prazni, a skup nema dodatnih clanova.
+Tokom javne operacije brojaci se sabiraju u promenljivama niti (bez atomskih operacija u petljama
+pretrage) i na kraju prenose u brojace skupa. Rad ugnezdenih javnih operacija (npr. pretrage
+drugog skupa u razlici) pripisuje se spoljnoj operaciji, a rad na drugim nitima (particije)
+skupovima cije operacije te niti izvrsavaju */
+class Instrumentacija
 {
 
-protected:
-	virtual void pisi(ostream& o) const = 0;
-
 public:
-	virtual ~Skup() {}
-
-	virtual bool PostojanjeElementa(int k) const = 0;
-	virtual Skup& UmetniElement(int k) = 0;
-	Skup& operator+=(int k);
+	enum Operacija
+	{
+		POSTOJANJE, POSTOJANJE_SERIJE, UMETANJE, UMETANJE_SERIJE, BRISANJE, BRISANJE_SERIJE, BRISANJE_OPSEGA, PRAZNJENJE,
+		RAZLIKA, RAZLIKA_U_MESTU, PRESEK, UNIJA, SIMETRICNA_RAZLIKA, PODSKUP, IMA_PRESEK, BROJ_U_OPSEGU, CUVANJE, UCITAVANJE,
+		BROJ_OPERACIJA
+	};
 
-	virtual Skup& ObrisiElement(int k) = 0;
-	Skup& operator-=(int k);
-	virtual Skup& ObrisiOpsegVrednosti(int min, int max) = 0;
+	static const int KORPI = 32; // korpa i: kasnjenja iz [2^i, 2^(i + 1)) ns, poslednja i sva duza
 
-	virtual int BrojElemenata() const = 0;
+	enum Format { TEKST, JSON };
 
-	virtual void IsprazniSkup() = 0;
+	// stanje brojaca u jednom trenutku
+	struct Izvestaj
+	{
+		bool ukljuceno; // false ako program nije preveden sa INSTRUMENTACIJA
+		uint64_t poziva[BROJ_OPERACIJA];
+		uint64_t ukupnoNs[BROJ_OPERACIJA];
+		uint64_t kasnjenja[BROJ_OPERACIJA][KORPI];
+		uint64_t poredjenja;
+		uint64_t posecenihCvorova;
+		uint64_t alokacija;
+		uint64_t najvecaDubina; // najvise cvorova posecenih u jednoj operaciji nad jednim kljucem
 
-	enum Greska { INDEKS, TIP };
+		Izvestaj();
 
-	virtual Skup* Razlika(const Skup& s2) const = 0;
-	friend Skup* operator-(const Skup& s1, const Skup& s2);
+		// gornja granica korpe do koje je ukupno bar deo p poziva, u ns
+		uint64_t Kvantil(Operacija op, double p) const;
 
-	friend ostream& operator<<(ostream& o, const Skup& s);
+		void Ispisi(ostream& o, Format format) const;
+	};
 
-};
+	static const char* Naziv(Operacija op);
 
-#pragma endregion
+	// broj koraka binarne pretrage niza od n elemenata
+	static int BrojKoraka(size_t n);
 
-#pragma region "PerformanceCalculator.h"
+#ifdef INSTRUMENTACIJA
+	Instrumentacija() { Ponisti(); }
+	// nov skup (i kopija) pocinje od nule, a dodela ne menja brojace odredisnog skupa
+	Instrumentacija(const Instrumentacija&) :Instrumentacija() {}
+	Instrumentacija& operator=(const Instrumentacija&) { return *this; }
 
-class PerformanceCalculator
-{
-	LARGE_INTEGER startCounter;
-	LARGE_INTEGER stopCounter;
-	LARGE_INTEGER frequency;
+	Izvestaj Stanje() const;
+	void Ponisti();
 
-public:
-	PerformanceCalculator()
+	// meri javnu operaciju od konstrukcije do unistenja; merenja ugnezdena u njoj na istoj niti se ne racunaju
+	class Merac
 	{
-		startCounter.QuadPart = stopCounter.QuadPart = 0;
-		QueryPerformanceFrequency(&frequency);
-	}
+		Instrumentacija* instrumentacija; // nullptr za ugnezdeno merenje
+		Operacija operacija;
+		chrono::steady_clock::time_point pocetak;
 
-	void start()
-	{
-		QueryPerformanceCounter(&startCounter);
-	}
+	public:
+		Merac(Instrumentacija& i, Operacija op);
+		~Merac();
+	};
 
-	void stop()
+	// brojaci operacije koja je u toku na ovoj niti
+	struct Lokalno
 	{
-		QueryPerformanceCounter(&stopCounter);
-	}
+		uint64_t poredjenja;
+		uint64_t posecenih;
+		uint64_t alokacija;
+		bool aktivno;
+	};
 
-	double elapsedMillis() const
-	{
-		return (stopCounter.QuadPart - startCounter.QuadPart)*1000. / frequency.QuadPart;
-	}
+	static thread_local Lokalno lokalno;
+
+private:
+	atomic<uint64_t> poziva[BROJ_OPERACIJA];
+	atomic<uint64_t> ukupnoNs[BROJ_OPERACIJA];
+	atomic<uint64_t> kasnjenja[BROJ_OPERACIJA][KORPI];
+	atomic<uint64_t> poredjenja;
+	atomic<uint64_t> posecenihCvorova;
+	atomic<uint64_t> alokacija;
+	atomic<uint64_t> najvecaDubina;
+#endif
 
 };
 
+#ifdef INSTRUMENTACIJA
+#define INSTRUMENTISI(operacija) Instrumentacija::Merac meracOperacije(instrumentacija, Instrumentacija::operacija)
+#define BROJI_POREDJENJA(n) (Instrumentacija::lokalno.poredjenja += (n))
+#define BROJI_POSETU(n) (Instrumentacija::lokalno.posecenih++, Instrumentacija::lokalno.poredjenja += (n))
+#define BROJI_ALOKACIJU() (Instrumentacija::lokalno.alokacija++)
+#else
+#define INSTRUMENTISI(operacija) ((void)0)
+#define BROJI_POREDJENJA(n) ((void)0)
+#define BROJI_POSETU(n) ((void)0)
+#define BROJI_ALOKACIJU() ((void)0)
+#endif
+
 #pragma endregion
 
-#pragma region "AnalizatorPerformansi.h"
+#pragma region "Bazen.h"
 
-class AnalizatorPerformansi
+struct StatistikaAlokacije
 {
+	long long alokacija;	// ukupan broj uzetih cvorova
+	long long oslobadjanja;	// ukupan broj vracenih cvorova
+	long long blokova;		// broj blokova trenutno uzetih od sistema
+	long long bajtova;		// memorija trenutno uzeta od sistema
 
-public:
-	static double FormirajSkup(Skup& skup, int velicina, int seme);
-	static double Umetanje(Skup& skup, int novi);
-	static double Brisanje(Skup& skup, int k);
-	static double Pretraga(Skup& skup, int k, bool& postoji);
-	static double BrisanjeOpsegaVrednosti(Skup& skup, int min, int max);
-	static double Razlika(Skup & s1, Skup & s2, int velicina);
+	StatistikaAlokacije() :alokacija(0), oslobadjanja(0), blokova(0), bajtova(0) {}
 
+	// zbir za skupove sa vise bazena
+	StatistikaAlokacije& operator+=(const StatistikaAlokacije& s)
+	{
+		alokacija += s.alokacija;
+		oslobadjanja += s.oslobadjanja;
+		blokova += s.blokova;
+		bajtova += s.bajtova;
+		return *this;
+	}
 };
 
-#pragma endregion
-
-#pragma region "BSTSkup.h"
-
-class BSTSkup : public Skup
+/* alokator cvorova fiksne velicine: cvorovi se uzimaju iz velikih blokova, oslobodjeni se
+vracaju u listu slobodnih i ponovo koriste, a ceo bazen se oslobadja u O(broj blokova) */
+template <class T>
+class Bazen
 {
 
 private:
-	class Cvor
+	union Slot
 	{
-	public:
-		int kljuc;
-		Cvor* levi;
-		Cvor* desni;
+		Slot* sledeci; // dok je slot u listi slobodnih
+		alignas(T) unsigned char sadrzaj[sizeof(T)];
+	};
 
-		Cvor(int _kljuc, Cvor* _levi = nullptr, Cvor* _desni = nullptr) :kljuc(_kljuc), levi(_levi), desni(_desni) {}
+	struct Blok
+	{
+		Blok* sledeci;
+		size_t velicina; // broj slotova koji slede iza zaglavlja bloka
 	};
 
-	Cvor* koren;
-	int n;
+	static const size_t POCETNI_BLOK = 64;
+	static const size_t MAKS_BLOK = 64 * 1024;
 
-	void kopiraj(const BSTSkup& s);
-	void premesti(BSTSkup& ss);
-	void obrisi();
+	Blok* blokovi;		// tekuci blok je prvi u listi
+	Slot* slobodni;
+	size_t iskorisceno;	// broj slotova tekuceg bloka koji su bar jednom dodeljeni
+	StatistikaAlokacije statistika;
 
-	Cvor* pronadiElement(int k, Cvor* koren) const;
+	static inline Slot* slotovi(Blok* b) { return reinterpret_cast<Slot*>(reinterpret_cast<unsigned char*>(b) + zaglavljeBloka()); }
+	static inline size_t zaglavljeBloka() { return (sizeof(Blok) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot); }
 
-	void pisi(ostream& o) const override;
+	void noviBlok();
 
 public:
-	BSTSkup() : koren(nullptr), n(0) {}
-	BSTSkup(const BSTSkup& s) { kopiraj(s); }
-	BSTSkup(BSTSkup&& ss) { premesti(ss); }
-	~BSTSkup() override { obrisi(); }
-
-	BSTSkup& operator=(const BSTSkup& s);
-	BSTSkup& operator=(BSTSkup&& s);
+	Bazen() :blokovi(nullptr), slobodni(nullptr), iskorisceno(0) {}
+	Bazen(const Bazen&) = delete;
+	Bazen& operator=(const Bazen&) = delete;
+	~Bazen() { OslobodiSve(); }
 
-	bool PostojanjeElementa(int k) const override;
-	BSTSkup& UmetniElement(int k) override;
-
-	BSTSkup& ObrisiElement(int k) override;
-	BSTSkup& ObrisiOpsegVrednosti(int min, int max) override;
+	template <class... Argumenti>
+	T* Napravi(Argumenti&&... argumenti);
+	void Unisti(T* p);
 
-	int BrojElemenata() const override { return n; }
+	// vraca sve blokove sistemu bez poziva destruktora - zivi cvorovi moraju biti trivijalno unistivi
+	void OslobodiSve();
 
-	void IsprazniSkup() override;
+	void Zameni(Bazen& b);
 
-	BSTSkup* Razlika(const Skup& s2) const;
+	const StatistikaAlokacije& Statistika() const { return statistika; }
 };
 
-#pragma endregion
-
-#pragma region "DCLLSkup.h"
+template <class T>
+void Bazen<T>::noviBlok()
+{
+	// blokovi rastu geometrijski da mali skupovi ne bi zauzimali mnogo memorije
+	size_t velicina = blokovi == nullptr ? POCETNI_BLOK : blokovi->velicina * 2;
+	if (velicina > MAKS_BLOK)
+		velicina = MAKS_BLOK;
+
+	size_t bajtova = zaglavljeBloka() + velicina * sizeof(Slot);
+	// blok je poravnat kao slot, pa cvorovi poravnati na liniju kesa (alignas) to zaista i jesu
+	Blok* b = static_cast<Blok*>(::operator new(bajtova, align_val_t(alignof(Slot))));
+	b->sledeci = blokovi;
+	b->velicina = velicina;
+
+	blokovi = b;
+	iskorisceno = 0;
+
+	statistika.blokova++;
+	statistika.bajtova += bajtova;
+}
 
-class DCLLSkup : public Skup
+template <class T>
+template <class... Argumenti>
+inline T* Bazen<T>::Napravi(Argumenti&&... argumenti)
 {
+	Slot* slot;
 
-private:
-	class Element
+	if (slobodni != nullptr) // ponovna upotreba oslobodjenog slota
 	{
-	public:
-		Element * prethodni;
-		int broj;
-		Element* sledeci;
-
-		Element(int _broj, Element* _prethodni = nullptr, Element* _sledeci = nullptr) :broj(_broj), prethodni(_prethodni), sledeci(_sledeci) {}
-	};
-
-	class Zaglavlje : public Element
+		slot = slobodni;
+		slobodni = slobodni->sledeci;
+	}
+	else
 	{
-	public:
-		// polje broj iz klase Element se koristi za cuvanje broja elemenata liste
-
-		Zaglavlje(int _broj, Element* _prethodni = nullptr, Element* _sledeci = nullptr) : Element(_broj, _prethodni, _sledeci) {}
-	};
-
-	enum Operacija { DODAVANJE, BRISANJE };
-
-	Zaglavlje* pZaglavlje;
-
-	void kopiraj(const DCLLSkup& s);
-	void premesti(DCLLSkup& s);
-	void obrisi();
-
-	inline void inicijalizuj();
-
-	inline void azurirajZaglavlje(Operacija op);
+		if (blokovi == nullptr || iskorisceno == blokovi->velicina)
+			noviBlok();
 
-	inline void dodajNakon(Element *p, int k);
-	inline void dodajPre(Element *p, int k);
+		slot = slotovi(blokovi) + iskorisceno++;
+	}
 
-	void pisi(ostream& o) const override;
+	statistika.alokacija++;
+	BROJI_ALOKACIJU();
 
-public:
-	DCLLSkup() { inicijalizuj(); }
-	DCLLSkup(const DCLLSkup& s) { kopiraj(s); }
-	DCLLSkup(DCLLSkup&& ss) { premesti(ss); }
-	~DCLLSkup() override { obrisi(); }
+	return new (slot->sadrzaj) T(std::forward<Argumenti>(argumenti)...);
+}
 
-	DCLLSkup& operator=(const DCLLSkup& s);
-	DCLLSkup& operator=(DCLLSkup&& s);
+template <class T>
+inline void Bazen<T>::Unisti(T* p)
+{
+	p->~T();
 
-	bool PostojanjeElementa(int k) const override;
-	DCLLSkup& UmetniElement(int k) override;
+	Slot* slot = reinterpret_cast<Slot*>(p);
+	slot->sledeci = slobodni;
+	slobodni = slot;
 
-	DCLLSkup& ObrisiElement(int k) override;
-	DCLLSkup& ObrisiOpsegVrednosti(int min, int max) override;
+	statistika.oslobadjanja++;
+}
 
-	int BrojElemenata() const override;
+template <class T>
+void Bazen<T>::OslobodiSve()
+{
+	while (blokovi != nullptr)
+	{
+		Blok* sledeci = blokovi->sledeci;
+		::operator delete(blokovi, align_val_t(alignof(Slot)));
+		blokovi = sledeci;
+	}
 
-	void IsprazniSkup() override;
+	slobodni = nullptr;
+	iskorisceno = 0;
 
-	DCLLSkup* Razlika(const Skup& s2) const;
+	statistika.oslobadjanja = statistika.alokacija;
+	statistika.blokova = 0;
+	statistika.bajtova = 0;
+}
 
-};
+template <class T>
+void Bazen<T>::Zameni(Bazen& b)
+{
+	swap(blokovi, b.blokovi);
+	swap(slobodni, b.slobodni);
+	swap(iskorisceno, b.iskorisceno);
+	swap(statistika, b.statistika);
+}
 
 #pragma endregion
 
 #pragma region "Stek.h"
 
-template <class T>
+/* stek u kontinualnoj memoriji: prvih UGRADJENO elemenata staje u sam objekat, pa plitki
+obilasci (npr. AVL stabla) ne koriste dinamicku memoriju; iznad toga niz raste geometrijski */
+template <class T, size_t UGRADJENO = 64>
 class Stek
 {
 
 private:
-	struct Element
-	{
-		T sadrzaj;
-		Element* sledeci;
+	alignas(T) unsigned char ugradjeni[UGRADJENO * sizeof(T)];
 
-		Element(T _sadrzaj, Element* _sledeci = nullptr) :sadrzaj(_sadrzaj), sledeci(_sledeci) {}
-	};
+	T* niz;				// ugradjeni niz ili niz na hipu
+	size_t broj;
+	size_t kapacitet;
 
-	Element* pokazivac;
+	inline T* ugradjeniNiz() { return reinterpret_cast<T*>(ugradjeni); }
+	inline bool naHipu() const { return niz != reinterpret_cast<const T*>(ugradjeni); }
 
 	void kopiraj(const Stek& s);
 	void premesti(Stek&& s);
 	void obrisi();
 
 public:
-	Stek() :pokazivac(nullptr) {}
-	Stek(const Stek& s) { kopiraj(s); }
-	Stek(Stek&& s) { premesti(s); }
+	Stek() :niz(ugradjeniNiz()), broj(0), kapacitet(UGRADJENO) {}
+	Stek(const Stek& s) :niz(ugradjeniNiz()), broj(0), kapacitet(UGRADJENO) { kopiraj(s); }
+	Stek(Stek&& s) :niz(ugradjeniNiz()), broj(0), kapacitet(UGRADJENO) { premesti(std::move(s)); }
 	~Stek() { obrisi(); }
 
 	Stek& operator=(const Stek& s);
 	Stek& operator=(Stek&& s);
 
+	void Rezervisi(size_t n);
+
 	void Dodaj(T _element);
 	bool Prazan() const;
 	T Uzmi();
 	T Vrh() const;
+	size_t Velicina() const { return broj; }
 
 	enum SGreska { PRAZAN };
 
 };
 
-template<class T>
-inline void Stek<T>::kopiraj(const Stek & s)
+template<class T, size_t UGRADJENO>
+inline void Stek<T, UGRADJENO>::kopiraj(const Stek & s)
 {
-	Element* original = s.pokazivac;
-	Element* p = nullptr;
-	Element* q = nullptr;
+	Rezervisi(s.broj);
+
+	for (size_t i = 0; i < s.broj; i++)
+		new (niz + i) T(s.niz[i]);
+
+	broj = s.broj;
+}
 
-	while (original)
+template<class T, size_t UGRADJENO>
+inline void Stek<T, UGRADJENO>::premesti(Stek && s)
+{
+	if (s.naHipu()) // preuzimanje niza sa hipa
 	{
-		if (q == nullptr)
-			q = p = pokazivac = new Element(original->sadrzaj);
-		else
+		niz = s.niz;
+		broj = s.broj;
+		kapacitet = s.kapacitet;
+	}
+	else // elementi ugradjenog niza se moraju premestiti jedan po jedan
+	{
+		for (size_t i = 0; i < s.broj; i++)
 		{
-			q = p;
-			p = new Element(original->sadrzaj);
-			q->sledeci = p;
+			new (niz + i) T(std::move(s.niz[i]));
+			s.niz[i].~T();
 		}
 
-		original = original->sledeci;
+		broj = s.broj;
 	}
-}
 
-template<class T>
-inline void Stek<T>::premesti(Stek && s)
-{
-	pokazivac = s.pokazivac;
-	s.pokazivac = nullptr;
+	s.niz = s.ugradjeniNiz();
+	s.broj = 0;
+	s.kapacitet = UGRADJENO;
 }
 
-template<class T>
-inline void Stek<T>::obrisi()
+template<class T, size_t UGRADJENO>
+inline void Stek<T, UGRADJENO>::obrisi()
 {
-	while (pokazivac)
-	{
-		Element* tmp = pokazivac->sledeci;
-		delete pokazivac;
-		pokazivac = tmp;
-	}
+	for (size_t i = 0; i < broj; i++)
+		niz[i].~T();
+
+	if (naHipu())
+		::operator delete(niz);
+
+	niz = ugradjeniNiz();
+	broj = 0;
+	kapacitet = UGRADJENO;
 }
 
-template<class T>
-inline Stek<T> & Stek<T>::operator=(const Stek & s)
+template<class T, size_t UGRADJENO>
+inline Stek<T, UGRADJENO> & Stek<T, UGRADJENO>::operator=(const Stek & s)
 {
 	if (this != &s) { obrisi(); kopiraj(s); }
 	return *this;
 }
 
-template<class T>
-inline Stek<T> & Stek<T>::operator=(Stek && s)
+template<class T, size_t UGRADJENO>
+inline Stek<T, UGRADJENO> & Stek<T, UGRADJENO>::operator=(Stek && s)
 {
-	if (this != &s) { obrisi(); premesti(s); }
+	if (this != &s) { obrisi(); premesti(std::move(s)); }
 	return *this;
 }
 
-template<class T>
-inline void Stek<T>::Dodaj(T _element)
+template<class T, size_t UGRADJENO>
+void Stek<T, UGRADJENO>::Rezervisi(size_t n)
+{
+	if (n <= kapacitet)
+		return;
+
+	T* novi = static_cast<T*>(::operator new(n * sizeof(T)));
+
+	for (size_t i = 0; i < broj; i++)
+	{
+		new (novi + i) T(std::move(niz[i]));
+		niz[i].~T();
+	}
+
+	if (naHipu())
+		::operator delete(niz);
+
+	niz = novi;
+	kapacitet = n;
+}
+
+template<class T, size_t UGRADJENO>
+inline void Stek<T, UGRADJENO>::Dodaj(T _element)
 {
-	pokazivac = new Element(_element, pokazivac);
+	if (broj == kapacitet) // amortizovano O(1)
+		Rezervisi(2 * kapacitet);
+
+	new (niz + broj) T(std::move(_element));
+	broj++;
 }
 
-template<class T>
-inline bool Stek<T>::Prazan() const
+template<class T, size_t UGRADJENO>
+inline bool Stek<T, UGRADJENO>::Prazan() const
 {
-	return pokazivac == nullptr;
+	return broj == 0;
 }
 
-template<class T>
-inline T Stek<T>::Uzmi()
+template<class T, size_t UGRADJENO>
+inline T Stek<T, UGRADJENO>::Uzmi()
 {
-	if (pokazivac == nullptr)
+	if (broj == 0)
 		throw PRAZAN;
 	else
 	{
-		T rez = pokazivac->sadrzaj;
-
-		Element* tmp = pokazivac;
-		pokazivac = pokazivac->sledeci;
-		delete tmp;
+		T rez = std::move(niz[--broj]);
+		niz[broj].~T();
 
 		return rez;
 	}
 }
 
-template<class T>
-inline T Stek<T>::Vrh() const
+template<class T, size_t UGRADJENO>
+inline T Stek<T, UGRADJENO>::Vrh() const
 {
-	if (pokazivac != nullptr)
-		return pokazivac->sadrzaj;
+	if (broj != 0)
+		return niz[broj - 1];
 	else
 		throw PRAZAN;
 }
 
 #pragma endregion
 
-#pragma region "AnalizatorPerformansi.cpp"
+#pragma region "BazenNiti.h"
 
-double AnalizatorPerformansi::FormirajSkup(Skup & skup, int velicina, int seme)
+/* bazen niti za paralelne operacije nad skupovima: Izvrsi deli poslove 0..poslova-1 izmedju
+radnika i pozivaoca i vraca se kada su svi zavrseni. Serije se izvrsavaju jedna po jedna, a
+posao ne sme da baca izuzetke niti da sam poziva Izvrsi istog bazena */
+class BazenNiti
 {
-	PerformanceCalculator pc;
-	double t = 0; // vreme
 
-				  // merenje formiranja tri puta
-	for (int i = 1; i <= 3; i++)
-	{
-		if (i != 1)
-			skup.IsprazniSkup();
+private:
+	vector<thread> radnici;
 
-		pc.start();
+	mutex brava;
+	mutex izvrsavanje;			// jedna serija u jednom trenutku
+	condition_variable novaSerija;
+	condition_variable krajSerije;
 
-		srand(seme);
-		// dodavanje 'velicina' elemenata
-		for (int k = 1; k <= velicina; k++)
-		{
-			// bolje performanse daje usvojeno resenje od komentarisanog 998 500/1 000 000
-			int b = rand()*(RAND_MAX + 1) + rand();
-			//(int)(rand() / ((double)RAND_MAX)*(2 * velicina)); // * (high - low) + low
+	const function<void(int)>* posao;
+	int poslova;
+	atomic<int> sledeci;		// sledeci neuzet posao tekuce serije
+	int zavrseno;
+	int aktivnih;				// radnici koji jos rade na tekucoj seriji
+	long long serija;
+	exception_ptr greska;		// prvi izuzetak iz poslova tekuce serije, ponovo se baca u Izvrsi
+	bool gasenje;
 
-			skup.UmetniElement(b);
-		}
+	void radi();
+	void obradi(const function<void(int)>& f, int broj);
 
-		pc.stop();
-		t += pc.elapsedMillis();
-	}
+public:
+	explicit BazenNiti(int brojRadnika);
+	BazenNiti(const BazenNiti&) = delete;
+	BazenNiti& operator=(const BazenNiti&) = delete;
+	~BazenNiti();
 
-	return t / 3;
-}
+	int BrojNiti() const { return (int)radnici.size() + 1; } // i pozivalac obradjuje poslove
 
-double AnalizatorPerformansi::Umetanje(Skup & skup, int novi)
-{
-	PerformanceCalculator pc;
+	// poziva f(0) .. f(broj - 1) na svim nitima; prvi izuzetak iz f se baca tek kada se zavrse svi poslovi
+	void Izvrsi(int broj, const function<void(int)>& f);
 
-	pc.start();
-	skup.UmetniElement(novi);
-	pc.stop();
+	// zajednicki bazen sa po jednom niti za svako jezgro
+	static BazenNiti& Zajednicki();
+};
 
-	return pc.elapsedMillis();
-}
+#pragma endregion
 
-double AnalizatorPerformansi::Brisanje(Skup & skup, int k)
+#pragma region "Skup.h"
+
+class Skup
 {
-	PerformanceCalculator pc;
 
-	pc.start();
-	skup.ObrisiElement(k);
-	pc.stop();
+protected:
+#ifdef INSTRUMENTACIJA
+	mutable Instrumentacija instrumentacija;
+#endif
 
-	return pc.elapsedMillis();
-}
+	virtual void pisi(ostream& o) const = 0;
 
-double AnalizatorPerformansi::Pretraga(Skup & skup, int k, bool & postoji)
-{
-	PerformanceCalculator pc;
-	double t = 0;
+	// sortira seriju (osim ako vec nije sortirana) i izbacuje ponavljanja
+	static void pripremiSeriju(vector<int>& kljucevi);
 
-	for (int i = 1; i <= 3; i++)
-	{
-		pc.start();
-		postoji = skup.PostojanjeElementa(k);
-		pc.stop();
-		t += pc.elapsedMillis();
-	}
+	// delovi dva skupa pri spajanju sortiranih nizova kljuceva: unija su sva tri,
+	// presek OBA, razlika SAMO_PRVI, a simetricna razlika SAMO_PRVI | SAMO_DRUGI
+	enum Deo { SAMO_PRVI = 1, OBA = 2, SAMO_DRUGI = 4, SVI = 7 };
 
-	return t / 3;
-}
+	// novi skup iste vrste sa kljucevima iz zadatih delova; s2 moze biti bilo koje vrste
+	virtual Skup* spojiSa(const Skup& s2, int delovi) const = 0;
+	// da li postoji bar jedan kljuc u zadatim delovima - spajanje se prekida na prvom
+	virtual bool postoji(const Skup& s2, int delovi) const = 0;
+	// preuzima sadrzaj skupa iste vrste (rezultata operacije nad ovim skupom) i brise ga
+	virtual void preuzmi(Skup* s) = 0;
 
-double AnalizatorPerformansi::BrisanjeOpsegaVrednosti(Skup & skup, int min, int max)
-{
-	PerformanceCalculator pc;
+	// da li je m pojedinacnih operacija od O(log n) jeftinije od spajanja u O(n + m)
+	static bool pojedinacno(int m, int n);
 
-	pc.start();
-	skup.ObrisiOpsegVrednosti(min, max);
-	pc.stop();
+	// ispod ovoliko kljuceva paralelne operacije rade na jednoj niti
+	static const int MIN_PARALELNO = 1 << 16;
 
-	return pc.elapsedMillis();
-}
+	// kljuc priblizno na mestu i * n / delova, za podelu posla po opsezima kljuceva;
+	// podrazumevano linearnom interpolacijom izmedju najmanjeg i najveceg kljuca
+	virtual int kvantil(int i, int delova) const;
 
-double AnalizatorPerformansi::Razlika(Skup & s1, Skup & s2, int velicina)
-{
-	PerformanceCalculator pc;
+	// sortiranje delova na svim nitima zajednickog bazena, pa spajanje parova delova
+	static void sortirajParalelno(vector<int>& kljucevi);
 
-	// formiranje elemenata drugog skupa
-	for (int i = 1; i <= velicina; i++)
-	{
-		// 0 do 2 * 'velicina'
-		int b = rand()*(RAND_MAX + 1) + rand();
+	// prazan skup iste vrste (i podesavanja) kao ovaj
+	virtual Skup* prazan() const = 0;
 
-		s2.UmetniElement(b);
-	}
+	/* pozicije za Iterator: svaka vrsta ih tumaci na svoj nacin (adresa cvora, indeks u nizu...);
+	prethodna pozicija kraja je poslednji element */
+	virtual uintptr_t pozicijaNeManjegOd(int k) const = 0;
+	virtual uintptr_t pozicijaKraja() const = 0;
+	virtual uintptr_t sledecaPozicija(uintptr_t p) const = 0;
+	virtual uintptr_t prethodnaPozicija(uintptr_t p) const = 0;
+	virtual int kljucNaPoziciji(uintptr_t p) const = 0;
 
-	double t = 0;
+	/* spajanje preko dva kursora (bilo koje vrste sa Vazeci, Kljuc, Sledeci i Trazi): f se poziva
+	za kljuceve iz zadatih delova i vraca false za prekid, a deo koji nije trazen se preskace
+	pretragom - npr. presek naizmenicno trazi tekuci kljuc drugog kursora */
+	template <class K1, class K2, class F>
+	static void spajanjeKursora(K1& a, K2& b, int delovi, F f);
 
-	for (int i = 1; i <= 3; i++)
-	{
-		pc.start();
-		Skup* rez = s1 - s2;
-		pc.stop();
-		t += pc.elapsedMillis();
-		delete rez;
-	}
+	// operacije nad skupovima razlicitih vrsta
+	Skup* spojiKursorima(const Skup& s2, int delovi) const;
+	bool postojiKursorima(const Skup& s2, int delovi) const;
+	void razlikaUMestuKursorima(const Skup& s2);
 
-	return t / 3;
+public:
+	virtual ~Skup() {}
+
+	virtual bool PostojanjeElementa(int k) const = 0;
+	/* serija upita odjednom - rezultat[i] je PostojanjeElementa(kljucevi[i]); podrazumevano kljuc
+	po kljuc, a serija velika u odnosu na skup se sortira i prolazi jednim kursorom */
+	virtual void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const;
+	virtual Skup& UmetniElement(int k) = 0;
+	Skup& operator+=(int k);
+
+	// umetanje serije kljuceva odjednom; podrazumevano element po element, a vrste koje mogu
+	// formiraju strukturu direktno iz sortirane serije u O(n)
+	virtual Skup& UmetniElemente(const int* niz, int broj);
+	// isto, ali se serija sortira na vise niti pre gradjenja
+	Skup& UmetniElementeParalelno(const int* niz, int broj);
+
+	virtual Skup& ObrisiElement(int k) = 0;
+	Skup& operator-=(int k);
+	// brisanje serije kljuceva odjednom - razlika sa skupom koji cini serija
+	virtual Skup& ObrisiElemente(const int* niz, int broj);
+	virtual Skup& ObrisiOpsegVrednosti(int min, int max) = 0;
+
+	virtual int BrojElemenata() const = 0;
+
+	virtual void IsprazniSkup() = 0;
+
+	// SAMO_ZA_CITANJE - izmena skupa koji se ne moze menjati, FORMAT - neispravan binarni snimak
+	enum Greska { INDEKS, TIP, SAMO_ZA_CITANJE, FORMAT };
+
+	virtual Skup* Razlika(const Skup& s2) const = 0;
+	friend Skup* operator-(const Skup& s1, const Skup& s2);
+
+	/* razlika na vise niti: kljucevi se dele na opsege, svaki opseg spajaju dva kursora
+	postavljena pretragom na njegov pocetak, a delovi rezultata se nadovezuju; oba skupa
+	se za to vreme samo citaju */
+	Skup* RazlikaParalelno(const Skup& s2) const;
+
+	// razlika bez pravljenja novog skupa - zajednicki elementi se izbacuju iz ovog skupa
+	virtual Skup& RazlikaUMestu(const Skup& s2) = 0;
+
+	Skup* Presek(const Skup& s2) const { INSTRUMENTISI(PRESEK); return spojiSa(s2, OBA); }
+	Skup* Unija(const Skup& s2) const { INSTRUMENTISI(UNIJA); return spojiSa(s2, SVI); }
+	Skup* SimetricnaRazlika(const Skup& s2) const { INSTRUMENTISI(SIMETRICNA_RAZLIKA); return spojiSa(s2, SAMO_PRVI | SAMO_DRUGI); }
+	friend Skup* operator&(const Skup& s1, const Skup& s2);
+	friend Skup* operator|(const Skup& s1, const Skup& s2);
+	friend Skup* operator^(const Skup& s1, const Skup& s2);
+
+	// rezultat se racuna kao kod operatora bez dodele, a zatim preuzima bez kopiranja;
+	// -= je RazlikaUMestu
+	Skup& operator&=(const Skup& s2);
+	Skup& operator|=(const Skup& s2);
+	Skup& operator^=(const Skup& s2);
+	Skup& operator-=(const Skup& s2);
+
+	// obe provere se zavrsavaju na prvom kljucu koji odlucuje ishod
+	bool JePodskupOd(const Skup& s2) const;
+	bool ImaPresek(const Skup& s2) const;
+
+	// brojaci i kasnjenja operacija ovog skupa od pravljenja ili poslednjeg ponistavanja;
+	// bez -DINSTRUMENTACIJA izvestaj je prazan (ukljuceno == false)
+	Instrumentacija::Izvestaj Merenja() const;
+	void PonistiMerenja();
+
+	/* kursor kroz kljuceve skupa u rastucem redosledu; svaka izmena skupa ga cini nevazecim.
+	Trazi se pomera samo unapred - na prvi kljuc koji nije manji od k */
+	class Kursor
+	{
+	public:
+		virtual ~Kursor() {}
+
+		virtual bool Vazeci() const = 0;
+		virtual int Kljuc() const = 0;
+		virtual void Sledeci() = 0;
+		virtual void Trazi(int k) = 0;
+	};
+
+	virtual unique_ptr<Kursor> NapraviKursor() const = 0;
+
+	/* dvosmerni iterator kroz kljuceve u rastucem redosledu (za STL algoritme i range-for);
+	ne alocira memoriju, a svaka izmena skupa ga cini nevazecim. Pozicija je jedna rec, pa kod
+	stabala korak bez desnog podstabla trazi sledbenika od korena (O(h)) - obilazak celog skupa
+	kroz Skup& ide kursorom, a konkretni iteratori stabala cuvaju put i nemaju taj trosak */
+	class Iterator
+	{
+		const Skup* skup;
+		uintptr_t pozicija;
+
+	public:
+		typedef bidirectional_iterator_tag iterator_category;
+		typedef int value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const int* pointer;
+		typedef int reference; // kljuc se vraca po vrednosti jer ga neke vrste ne cuvaju kao int
+
+		Iterator(const Skup* _skup = nullptr, uintptr_t _pozicija = 0) :skup(_skup), pozicija(_pozicija) {}
+
+		int operator*() const { return skup->kljucNaPoziciji(pozicija); }
+
+		Iterator& operator++() { pozicija = skup->sledecaPozicija(pozicija); return *this; }
+		Iterator& operator--() { pozicija = skup->prethodnaPozicija(pozicija); return *this; }
+		Iterator operator++(int) { Iterator i = *this; ++*this; return i; }
+		Iterator operator--(int) { Iterator i = *this; --*this; return i; }
+
+		bool operator==(const Iterator& i) const { return pozicija == i.pozicija && skup == i.skup; }
+		bool operator!=(const Iterator& i) const { return !(*this == i); }
+	};
+
+	Iterator begin() const { return Iterator(this, pozicijaNeManjegOd(INT_MIN)); }
+	Iterator end() const { return Iterator(this, pozicijaKraja()); }
+	Iterator lower_bound(int k) const { return Iterator(this, pozicijaNeManjegOd(k)); }
+	Iterator upper_bound(int k) const { return k == INT_MAX ? end() : lower_bound(k + 1); }
+
+	// broj elemenata u [min, max] bez izdvajanja elemenata; podrazumevano O(log n + k) preko iteratora
+	virtual int BrojUOpsegu(int min, int max) const;
+
+	// skupovi koji cvorove uzimaju iz sopstvenog bazena prijavljuju njegovo stanje
+	virtual StatistikaAlokacije StatistikaAlokatora() const { return StatistikaAlokacije(); }
+
+	friend ostream& operator<<(ostream& o, const Skup& s);
+
+	// binarni snimak (Snimak) - kljucevi se kodiraju redom, bez teksta
+	void Sacuvaj(ostream& o) const;
+	// sadrzaj skupa se zamenjuje sadrzajem snimka; FORMAT ako snimak nije ispravan i tada se skup ne menja
+	Skup& Ucitaj(istream& i);
+
+};
+
+template <class K1, class K2, class F>
+void Skup::spajanjeKursora(K1 & a, K2 & b, int delovi, F f)
+{
+	while (true)
+	{
+		if (!a.Vazeci() && (!b.Vazeci() || (delovi & SAMO_DRUGI) == 0))
+			return;
+		if (!b.Vazeci() && (delovi & SAMO_PRVI) == 0)
+			return;
+
+		if (!b.Vazeci() || (a.Vazeci() && a.Kljuc() < b.Kljuc()))
+		{
+			if ((delovi & SAMO_PRVI) == 0)
+				a.Trazi(b.Kljuc());
+			else
+			{
+				if (!f(a.Kljuc()))
+					return;
+				a.Sledeci();
+			}
+		}
+		else if (!a.Vazeci() || b.Kljuc() < a.Kljuc())
+		{
+			if ((delovi & SAMO_DRUGI) == 0)
+				b.Trazi(a.Kljuc());
+			else
+			{
+				if (!f(b.Kljuc()))
+					return;
+				b.Sledeci();
+			}
+		}
+		else
+		{
+			if ((delovi & OBA) != 0 && !f(a.Kljuc()))
+				return;
+			a.Sledeci();
+			b.Sledeci();
+		}
+	}
+}
+
+// nagovestaj procesoru da ucita liniju kesa na kojoj je p, bez cekanja
+static inline void predUcitaj(const void* p)
+{
+#if defined(__GNUC__)
+	__builtin_prefetch(p);
+#elif defined(_M_X64) || defined(_M_IX86)
+	_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#endif
+}
+
+// promena znaka bita cuva poredak: INT_MIN -> 0, INT_MAX -> 2^32 - 1
+static inline uint32_t uNeoznacen(int k) { return (uint32_t)k ^ 0x80000000u; }
+static inline int uOznacen(uint32_t u) { return (int)(u ^ 0x80000000u); }
+
+/* pretraga binarnog stabla pretrazivanja bez pokazivaca na roditelja (BSTSkup, AVLSkup) - sve O(h),
+i prestrukturiranje stabla preko sortirane liste, zajednicko za oba stabla */
+template <class Cvor>
+struct NavigacijaStabla
+{
+	/* vise spustanja odjednom: u svakom krugu svaki kljuc grupe silazi jedan nivo i unapred ucitava
+	sledeci cvor, pa se promasaji kesa za razlicite kljuceve preklapaju umesto da se cekaju redom */
+	static void Postoje(const Cvor* koren, const int* kljucevi, size_t broj, bool* rezultat)
+	{
+		const size_t GRUPA = 16;
+		const Cvor* p[GRUPA];
+
+		for (size_t od = 0; od < broj; od += GRUPA)
+		{
+			size_t n = min(GRUPA, broj - od);
+			for (size_t i = 0; i < n; i++)
+			{
+				p[i] = koren;
+				rezultat[od + i] = false;
+			}
+
+			for (bool aktivan = koren != nullptr; aktivan; )
+			{
+				aktivan = false;
+				for (size_t i = 0; i < n; i++)
+				{
+					if (p[i] == nullptr)
+						continue;
+
+					int k = kljucevi[od + i];
+					BROJI_POSETU(1);
+					if (k == p[i]->kljuc)
+					{
+						rezultat[od + i] = true;
+						p[i] = nullptr;
+						continue;
+					}
+
+					BROJI_POREDJENJA(1);
+					p[i] = k < p[i]->kljuc ? p[i]->levi : p[i]->desni;
+					if (p[i] != nullptr)
+					{
+						predUcitaj(p[i]);
+						aktivan = true;
+					}
+				}
+			}
+		}
+	}
+
+	static const Cvor* NeManjiOd(const Cvor* p, int k)
+	{
+		const Cvor* kandidat = nullptr;
+
+		while (p != nullptr)
+		{
+			BROJI_POSETU(1);
+			if (p->kljuc < k)
+				p = p->desni;
+			else
+			{
+				kandidat = p;
+				p = p->levi;
+			}
+		}
+
+		return kandidat;
+	}
+
+	static const Cvor* VeciOd(const Cvor* p, int k)
+	{
+		const Cvor* kandidat = nullptr;
+
+		while (p != nullptr)
+		{
+			BROJI_POSETU(1);
+			if (p->kljuc <= k)
+				p = p->desni;
+			else
+			{
+				kandidat = p;
+				p = p->levi;
+			}
+		}
+
+		return kandidat;
+	}
+
+	static const Cvor* ManjiOd(const Cvor* p, int k)
+	{
+		const Cvor* kandidat = nullptr;
+
+		while (p != nullptr)
+		{
+			BROJI_POSETU(1);
+			if (p->kljuc >= k)
+				p = p->levi;
+			else
+			{
+				kandidat = p;
+				p = p->desni;
+			}
+		}
+
+		return kandidat;
+	}
+
+	static const Cvor* Najveci(const Cvor* p)
+	{
+		if (p != nullptr)
+			while (p->desni != nullptr)
+				p = p->desni;
+
+		return p;
+	}
+
+	// sledbenik je najlevlji u desnom podstablu, a ako njega nema - trazi se spustanjem od korena
+	static const Cvor* Sledbenik(const Cvor* koren, const Cvor* p)
+	{
+		if (p->desni == nullptr)
+			return VeciOd(koren, p->kljuc);
+
+		for (p = p->desni; p->levi != nullptr; p = p->levi);
+		return p;
+	}
+
+	// od kraja (nullptr) prethodnik je najveci element
+	static const Cvor* Prethodnik(const Cvor* koren, const Cvor* p)
+	{
+		if (p == nullptr)
+			return Najveci(koren);
+		if (p->levi == nullptr)
+			return ManjiOd(koren, p->kljuc);
+
+		for (p = p->levi; p->desni != nullptr; p = p->desni);
+		return p;
+	}
+
+	// stablo u listu povezanu desnim pokazivacima - leva deca se rotacijama prebacuju udesno, bez steka
+	static Cvor* UListu(Cvor* koren)
+	{
+		Cvor glava(0, nullptr, koren);
+		Cvor* rep = &glava;
+
+		while (rep->desni != nullptr)
+		{
+			Cvor* p = rep->desni;
+
+			if (p->levi != nullptr) // rotacija udesno
+			{
+				Cvor* l = p->levi;
+				p->levi = l->desni;
+				l->desni = p;
+				rep->desni = l;
+			}
+			else
+				rep = p;
+		}
+
+		return glava.desni;
+	}
+
+	/* balansirano stablo od prvih broj cvorova sortirane liste, uz pomeranje glave liste - O(n), dubina
+	rekurzije O(log n); azuriraj(p, broj) popravlja podatke cvora (velicinu, visinu) kada su mu deca gotova */
+	template <class F>
+	static Cvor* IzListe(Cvor*& lista, int broj, F azuriraj)
+	{
+		if (broj == 0)
+			return nullptr;
+
+		Cvor* levo = IzListe(lista, broj / 2, azuriraj);
+
+		Cvor* p = lista;
+		lista = lista->desni;
+
+		p->levi = levo;
+		p->desni = IzListe(lista, broj - broj / 2 - 1, azuriraj);
+		azuriraj(p, broj);
+
+		return p;
+	}
+};
+
+/* konkretan iterator stabla - isti kao Skup::Iterator, ali bez virtuelnih poziva; cuva put od
+korena do tekuceg cvora, pa je korak amortizovano O(1) umesto spustanja od korena, a kopija O(h) */
+template <class Cvor>
+class IteratorStabla
+{
+	const Cvor* koren;
+	Stek<const Cvor*, 32> put; // vrh je tekuci cvor, prazan put je kraj
+
+	// put do prvog kljuca koji nije manji od k (ili je veci od k ako je strogo)
+	void spusti(int k, bool strogo)
+	{
+		const Cvor* kandidat = nullptr;
+		for (const Cvor* p = koren; p != nullptr; )
+		{
+			put.Dodaj(p);
+			if (p->kljuc > k || (!strogo && p->kljuc == k))
+			{
+				kandidat = p;
+				p = p->levi;
+			}
+			else
+				p = p->desni;
+		}
+
+		while (!put.Prazan() && put.Vrh() != kandidat)
+			put.Uzmi();
+	}
+
+	const Cvor* tekuci() const { return put.Prazan() ? nullptr : put.Vrh(); }
+
+public:
+	typedef bidirectional_iterator_tag iterator_category;
+	typedef int value_type;
+	typedef ptrdiff_t difference_type;
+	typedef const int* pointer;
+	typedef const int& reference;
+
+	IteratorStabla(const Cvor* _koren = nullptr) :koren(_koren) {}
+
+	static IteratorStabla NeManjiOd(const Cvor* koren, int k) { IteratorStabla i(koren); i.spusti(k, false); return i; }
+	static IteratorStabla VeciOd(const Cvor* koren, int k) { IteratorStabla i(koren); i.spusti(k, true); return i; }
+
+	const int& operator*() const { return put.Vrh()->kljuc; }
+	const int* operator->() const { return &put.Vrh()->kljuc; }
+
+	// najlevlji u desnom podstablu, a ako njega nema - prvi predak do kog se stiglo iz levog podstabla
+	IteratorStabla& operator++()
+	{
+		const Cvor* p = put.Vrh();
+		if (p->desni != nullptr)
+		{
+			for (p = p->desni; p != nullptr; p = p->levi)
+				put.Dodaj(p);
+		}
+		else
+		{
+			do
+				p = put.Uzmi();
+			while (!put.Prazan() && put.Vrh()->desni == p);
+		}
+
+		return *this;
+	}
+
+	// od kraja prethodnik je najveci element
+	IteratorStabla& operator--()
+	{
+		const Cvor* p = tekuci();
+		if (p == nullptr || p->levi != nullptr)
+		{
+			for (p = p == nullptr ? koren : p->levi; p != nullptr; p = p->desni)
+				put.Dodaj(p);
+		}
+		else
+		{
+			do
+				p = put.Uzmi();
+			while (!put.Prazan() && put.Vrh()->levi == p);
+		}
+
+		return *this;
+	}
+
+	IteratorStabla operator++(int) { IteratorStabla i = *this; ++*this; return i; }
+	IteratorStabla operator--(int) { IteratorStabla i = *this; --*this; return i; }
+
+	bool operator==(const IteratorStabla& i) const { return tekuci() == i.tekuci(); }
+	bool operator!=(const IteratorStabla& i) const { return tekuci() != i.tekuci(); }
+};
+
+// kursor kroz binarno stablo pretrazivanja (BSTSkup, AVLSkup) - na steku su preci ciji kljucevi jos nisu obidjeni
+template <class Cvor>
+class KursorStabla final : public Skup::Kursor
+{
+	const Cvor* koren;
+	Stek<const Cvor*> stek; // vrh je tekuci cvor
+
+	void spustiLevo(const Cvor* p)
+	{
+		for (; p != nullptr; p = p->levi)
+			stek.Dodaj(p);
+	}
+
+public:
+	KursorStabla(const Cvor* _koren) :koren(_koren) { spustiLevo(koren); }
+
+	bool Vazeci() const override { return !stek.Prazan(); }
+	int Kljuc() const override { return stek.Vrh()->kljuc; }
+
+	void Sledeci() override
+	{
+		spustiLevo(stek.Uzmi()->desni);
+	}
+
+	// stek se gradi iznova jednim spustanjem od korena - O(h)
+	void Trazi(int k) override
+	{
+		if (stek.Prazan() || stek.Vrh()->kljuc >= k)
+			return;
+
+		while (!stek.Prazan())
+			stek.Uzmi();
+
+		for (const Cvor* p = koren; p != nullptr; )
+		{
+			if (p->kljuc >= k)
+			{
+				stek.Dodaj(p);
+				p = p->levi;
+			}
+			else
+				p = p->desni;
+		}
+	}
+};
+
+#pragma endregion
+
+#pragma region "PerformanceCalculator.h"
+
+// prenosivo merenje vremena (steady_clock) uz opciono brojanje ciklusa procesora
+class PerformanceCalculator
+{
+public:
+	enum Brojac { BEZ_CIKLUSA, RDTSC, PERF_EVENT };
+
+private:
+	chrono::steady_clock::time_point startTime;
+	chrono::steady_clock::time_point stopTime;
+
+	Brojac brojac;
+	long long startCycles;
+	long long stopCycles;
+	int perfFd; // perf_event deskriptor (samo Linux), -1 ako nije otvoren
+
+	long long citajCikluse() const
+	{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		if (brojac == RDTSC)
+			return (long long)__rdtsc();
+#endif
+#if defined(__linux__)
+		long long vrednost;
+		if (brojac == PERF_EVENT && read(perfFd, &vrednost, sizeof(vrednost)) == sizeof(vrednost))
+			return vrednost;
+#endif
+		return 0;
+	}
+
+public:
+	PerformanceCalculator(Brojac _brojac = BEZ_CIKLUSA) : brojac(_brojac), startCycles(0), stopCycles(0), perfFd(-1)
+	{
+		startTime = stopTime = chrono::steady_clock::now();
+
+#if defined(__linux__)
+		if (brojac == PERF_EVENT)
+		{
+			perf_event_attr pe;
+			memset(&pe, 0, sizeof(pe));
+			pe.type = PERF_TYPE_HARDWARE;
+			pe.size = sizeof(pe);
+			pe.config = PERF_COUNT_HW_CPU_CYCLES;
+			pe.exclude_kernel = 1;
+			pe.exclude_hv = 1;
+
+			perfFd = (int)syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+		}
+#endif
+
+		if (!Podrzan(brojac) || (brojac == PERF_EVENT && perfFd < 0)) // npr. perf_event_paranoid ne dozvoljava pristup
+			brojac = BEZ_CIKLUSA;
+	}
+
+	~PerformanceCalculator()
+	{
+#if defined(__linux__)
+		if (perfFd >= 0)
+			close(perfFd);
+#endif
+	}
+
+	PerformanceCalculator(const PerformanceCalculator&) = delete;
+	PerformanceCalculator& operator=(const PerformanceCalculator&) = delete;
+
+	void start()
+	{
+		startCycles = citajCikluse();
+		startTime = chrono::steady_clock::now();
+	}
+
+	void stop()
+	{
+		stopTime = chrono::steady_clock::now();
+		stopCycles = citajCikluse();
+	}
+
+	double elapsedMillis() const
+	{
+		return chrono::duration<double, milli>(stopTime - startTime).count();
+	}
+
+	// -1 ako brojac ciklusa nije izabran ili nije dostupan
+	long long elapsedCycles() const
+	{
+		return brojac == BEZ_CIKLUSA ? -1 : stopCycles - startCycles;
+	}
+
+	static bool Podrzan(Brojac b)
+	{
+		if (b == RDTSC)
+		{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+			return true;
+#else
+			return false;
+#endif
+		}
+		else if (b == PERF_EVENT)
+		{
+#if defined(__linux__)
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		return true;
+	}
+
+};
+
+#pragma endregion
+
+#pragma region "AnalizatorPerformansi.h"
+
+struct StatistikaMerenja
+{
+	int uzoraka;
+	double min, medijana, p99, prosek, stdDev; // ms
+	double ciklusiMedijana; // -1 ako se ciklusi ne broje
+
+	StatistikaMerenja() :uzoraka(0), min(0), medijana(0), p99(0), prosek(0), stdDev(0), ciklusiMedijana(-1) {}
+};
+
+class AnalizatorPerformansi
+{
+
+public:
+	struct Konfiguracija
+	{
+		int zagrevanje;		// broj pocetnih merenja koja se odbacuju
+		int ponavljanja;	// broj merenja koja ulaze u rezultat
+		int trajanjeMs;		// trajanje jednog visenitnog merenja
+		PerformanceCalculator::Brojac brojac;
+
+		Konfiguracija() :zagrevanje(0), ponavljanja(3), trajanjeMs(200), brojac(PerformanceCalculator::BEZ_CIKLUSA) {}
+	};
+
+	enum Format { CSV, JSON };
+
+	static Konfiguracija konfiguracija;
+
+	static double FormirajSkup(Skup& skup, int velicina, int seme);
+	static double Umetanje(Skup& skup, int novi);
+	static double Brisanje(Skup& skup, int k);
+	static double Pretraga(Skup& skup, int k, bool& postoji);
+	static double BrisanjeOpsegaVrednosti(Skup& skup, int min, int max);
+	static double Razlika(Skup & s1, Skup & s2, int velicina);
+
+	static StatistikaMerenja Statistika(vector<double> uzorci, vector<long long> ciklusi);
+
+	/* svi scenariji nad svim vrstama skupova (ili samo nad zadatim), rezultat u CSV ili JSON formatu;
+	uz sve vrste i otvaranje i upiti nad snimkom otvorenim samo za citanje (MapiraniSkup) */
+	static void PokreniSve(ostream& o, Format format, int velicina, int seme, const vector<int>& vrste = vector<int>());
+
+	// propusnost citanja i pisanja na 1..maksNiti niti, samo za vrste koje se mogu deliti izmedju niti
+	static void PokreniVisenitno(ostream& o, Format format, int velicina, int seme, int maksNiti, const vector<int>& vrste = vector<int>());
+
+private:
+	static int slucajanKljuc();
+
+	static StatistikaMerenja meri(const function<void()>& priprema, const function<void()>& operacija, const function<void()>& vracanje);
+
+};
+
+#pragma endregion
+
+#pragma region "BSTSkup.h"
+
+class BSTSkup : public Skup
+{
+
+private:
+	class Cvor
+	{
+	public:
+		int kljuc;
+		int velicina; // broj cvorova podstabla - azuran samo u rezimu statistike poretka
+		Cvor* levi;
+		Cvor* desni;
+
+		Cvor(int _kljuc, Cvor* _levi = nullptr, Cvor* _desni = nullptr) :kljuc(_kljuc), velicina(1), levi(_levi), desni(_desni) {}
+	};
+
+	/* inorder obilazak bez steka (Morris): desni pokazivac inorder prethodnika se privremeno
+	usmerava na cvor, a pri drugom prolasku vraca; destruktor zavrsava obilazak, pa je stablo
+	nakon unistenja objekta nepromenjeno. Posto obilazak menja stablo, koristi se samo u izmenama
+	sopstvenog stabla - const operacije mogu teci istovremeno iz vise niti i koriste Obilazak */
+	class MorrisObilazak
+	{
+		Cvor* tekuci;
+
+	public:
+		MorrisObilazak(Cvor* koren) :tekuci(koren) {}
+		MorrisObilazak(const MorrisObilazak&) = delete;
+		MorrisObilazak& operator=(const MorrisObilazak&) = delete;
+		~MorrisObilazak() { while (Sledeci() != nullptr); }
+
+		Cvor* Sledeci();
+	};
+
+	/* inorder obilazak sa stekom predaka - stablo se samo cita, a prekid obilaska ne kosta nista.
+	Stek ne alocira dok je put kraci od ugradjenog niza; dublje (npr. levo iskosenom) stablo
+	dobija odjednom mesto za n cvorova, pa obilazak ima najvise jednu alokaciju */
+	class Obilazak
+	{
+		static const size_t UGRADJENO = 64;
+
+		Stek<const Cvor*, UGRADJENO> stek;
+		size_t n;
+
+		void spustiLevo(const Cvor* p)
+		{
+			for (; p != nullptr; p = p->levi)
+			{
+				if (stek.Velicina() == UGRADJENO)
+					stek.Rezervisi(n);
+				stek.Dodaj(p);
+			}
+		}
+
+	public:
+		Obilazak(const Cvor* koren, int _n) :n(_n) { spustiLevo(koren); }
+
+		const Cvor* Sledeci()
+		{
+			if (stek.Prazan())
+				return nullptr;
+
+			const Cvor* p = stek.Uzmi();
+			spustiLevo(p->desni);
+			return p;
+		}
+	};
+
+	Cvor* koren;
+	int n;
+	bool statistikaPoretka; // velicine podstabala se odrzavaju pri svakoj izmeni
+	Bazen<Cvor> bazen;
+
+	void kopiraj(const BSTSkup& s);
+	void premesti(BSTSkup& ss);
+	void obrisi();
+
+	Cvor* pronadiElement(int k, Cvor* koren) const;
+
+	static inline int velicina(const Cvor* p) { return p != nullptr ? p->velicina : 0; }
+	static void popraviKicmu(Cvor* p, bool desna);
+	int rang(int k, bool ukljuciK) const;
+	int kvantil(int i, int delova) const override;
+
+	static void razdvoji(Cvor* p, int k, bool ukljuciK, Cvor*& levo, Cvor*& desno);
+	static Cvor* spoji(Cvor* levo, Cvor* desno);
+	int obrisiPodstablo(Cvor* p);
+
+	Cvor* izgradi(const int* niz, int od, int doo);
+	static Cvor* izListe(Cvor*& lista, int broj);
+
+	void pisi(ostream& o) const override;
+
+	template <class F>
+	void spajanje(const BSTSkup& drugi, int delovi, F f) const;
+
+	BSTSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	BSTSkup* prazan() const override;
+
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	/* sa statistikom poretka svaki cvor pamti velicinu svog podstabla, pa su Rang, Izbor i
+	BrojUOpsegu O(h) umesto O(n), a umetanje i brisanje prolaze put do cvora jos jednom */
+	explicit BSTSkup(bool _statistikaPoretka = false) : koren(nullptr), n(0), statistikaPoretka(_statistikaPoretka) {}
+	BSTSkup(const BSTSkup& s) : koren(nullptr), n(0), statistikaPoretka(false) { kopiraj(s); }
+	BSTSkup(BSTSkup&& ss) : koren(nullptr), n(0), statistikaPoretka(false) { premesti(ss); }
+	~BSTSkup() override { obrisi(); }
+
+	BSTSkup& operator=(const BSTSkup& s);
+	BSTSkup& operator=(BSTSkup&& s);
+
+	bool StatistikaPoretka() const { return statistikaPoretka; }
+
+	bool PostojanjeElementa(int k) const override;
+	void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const override;
+	BSTSkup& UmetniElement(int k) override;
+	BSTSkup& UmetniElemente(const int* niz, int broj) override;
+
+	BSTSkup& ObrisiElement(int k) override;
+	BSTSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override { return n; }
+
+	void IsprazniSkup() override;
+
+	BSTSkup* Razlika(const Skup& s2) const;
+	BSTSkup& RazlikaUMestu(const Skup& s2) override;
+
+	int Rang(int k) const;	// broj elemenata manjih od k
+	int Izbor(int i) const;	// i-ti najmanji element (od 0)
+	int BrojUOpsegu(int min, int max) const override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	// konkretni iteratori (bez virtuelnih poziva) zaklanjaju one iz Skup
+	typedef IteratorStabla<Cvor> Iterator;
+
+	Iterator begin() const { return Iterator::NeManjiOd(koren, INT_MIN); }
+	Iterator end() const { return Iterator(koren); }
+	Iterator lower_bound(int k) const { return Iterator::NeManjiOd(koren, k); }
+	Iterator upper_bound(int k) const { return Iterator::VeciOd(koren, k); }
+
+	StatistikaAlokacije StatistikaAlokatora() const override { return bazen.Statistika(); }
+};
+
+/* zajednicki inorder obilazak dva stabla (kao u Razlika): f se poziva za kljuceve iz zadatih
+delova u rastucem redosledu i vraca false kada spajanje treba prekinuti */
+template <class F>
+void BSTSkup::spajanje(const BSTSkup & drugi, int delovi, F f) const
+{
+	if (&drugi == this) // svi kljucevi su u oba, pa je dovoljan jedan obilazak
+	{
+		if ((delovi & OBA) == 0)
+			return;
+
+		Obilazak obilazak(koren, n);
+		for (const Cvor* p = obilazak.Sledeci(); p != nullptr; p = obilazak.Sledeci())
+			if (!f(p->kljuc))
+				return;
+
+		return;
+	}
+
+	Obilazak obilazak1(koren, n), obilazak2(drugi.koren, drugi.n);
+
+	const Cvor* p1 = obilazak1.Sledeci();
+	const Cvor* p2 = obilazak2.Sledeci();
+
+	while (true)
+	{
+		// ostatak jednog stabla se ne obilazi ako taj deo nije trazen
+		if (p1 == nullptr && (p2 == nullptr || (delovi & SAMO_DRUGI) == 0))
+			return;
+		if (p2 == nullptr && (delovi & SAMO_PRVI) == 0)
+			return;
+
+		int deo, k;
+
+		if (p2 == nullptr || (p1 != nullptr && p1->kljuc < p2->kljuc))
+		{
+			deo = SAMO_PRVI;
+			k = p1->kljuc;
+			p1 = obilazak1.Sledeci();
+		}
+		else if (p1 == nullptr || p2->kljuc < p1->kljuc)
+		{
+			deo = SAMO_DRUGI;
+			k = p2->kljuc;
+			p2 = obilazak2.Sledeci();
+		}
+		else
+		{
+			deo = OBA;
+			k = p1->kljuc;
+			p1 = obilazak1.Sledeci();
+			p2 = obilazak2.Sledeci();
+		}
+
+		if ((delovi & deo) != 0 && !f(k))
+			return;
+	}
+}
+
+#pragma endregion
+
+#pragma region "DCLLSkup.h"
+
+class DCLLSkup : public Skup
+{
+
+private:
+	class Element
+	{
+	public:
+		Element * prethodni;
+		int broj;
+		Element* sledeci;
+
+		Element(int _broj, Element* _prethodni = nullptr, Element* _sledeci = nullptr) :prethodni(_prethodni), broj(_broj), sledeci(_sledeci) {}
+	};
+
+	class Zaglavlje : public Element
+	{
+	public:
+		// polje broj iz klase Element se koristi za cuvanje broja elemenata liste
+
+		Zaglavlje(int _broj, Element* _prethodni = nullptr, Element* _sledeci = nullptr) : Element(_broj, _prethodni, _sledeci) {}
+	};
+
+	/* opcioni indeks nad listom (skip lista): svaki element se sa verovatnocom 1/4 unapredjuje
+	u indeks, i dalje sa 1/4 u svaki visi nivo; pretraga se spusta kroz nivoe indeksa i zavrsava
+	u proseku sa nekoliko koraka kroz samu listu, pa su operacije nad jednim elementom O(log n) */
+	class Indeks
+	{
+	public:
+		static const int MAKS_NIVO = 16;
+		static const int NIVOA_U_CVORU = 2; // 15 od 16 cvorova indeksa nema vise nivoa od ovoga
+
+		struct Cvor
+		{
+			Element* element;
+			int nivo;
+			Cvor** sledeci; // po jedan pokazivac za svaki nivo - u samom cvoru ili u Veze za visoke cvorove
+			Cvor* ugradjeni[NIVOA_U_CVORU];
+
+			Cvor(Element* _element, int _nivo, Cvor** _sledeci = nullptr) :element(_element), nivo(_nivo), sledeci(_sledeci != nullptr ? _sledeci : ugradjeni)
+			{
+				for (int i = 0; i < nivo; i++)
+					sledeci[i] = nullptr;
+			}
+		};
+
+		struct Veze
+		{
+			Cvor* sledeci[MAKS_NIVO];
+		};
+
+	private:
+		Veze vezeGlave;
+		Cvor glava; // element glave je zaglavlje liste
+		int nivo;	// broj trenutno zauzetih nivoa
+		uint32_t stanje; // sopstveni generator da se ne bi remetio rand() korisnika
+
+		// cvorovi i nizovi veza visokih cvorova su iz bazena indeksa, kao elementi liste iz bazena skupa
+		Bazen<Cvor> cvorovi;
+		Bazen<Veze> veze;
+
+		int slucajanNivo();
+		Cvor* prethodnici(int k, Cvor** azuriranje);
+
+		Cvor* napravi(Element* e, int n);
+		void unisti(Cvor* x);
+
+	public:
+		Indeks(Element* zaglavlje) :glava(zaglavlje, MAKS_NIVO, vezeGlave.sledeci), nivo(0), stanje(2463534242u) {}
+		Indeks(const Indeks&) = delete;
+		Indeks& operator=(const Indeks&) = delete;
+
+		Element* Prethodnik(int k) const;
+		void Dodaj(Element* e);
+		void Ukloni(int k);
+		void UkloniOpseg(int min, int max);
+		void Izgradi();
+		void Isprazni();
+
+		StatistikaAlokacije Statistika() const;
+	};
+
+	// sa indeksom se Trazi spusta kroz indeks, a bez njega ide unapred kroz listu
+	class Kursor : public Skup::Kursor
+	{
+		const DCLLSkup* skup;
+		const Element* tekuci;
+
+	public:
+		Kursor(const DCLLSkup* _skup) :skup(_skup), tekuci(_skup->pZaglavlje->sledeci) {}
+
+		bool Vazeci() const override { return tekuci != skup->pZaglavlje; }
+		int Kljuc() const override { return tekuci->broj; }
+		void Sledeci() override { tekuci = tekuci->sledeci; }
+		void Trazi(int k) override;
+	};
+
+	enum Operacija { DODAVANJE, BRISANJE };
+
+	Zaglavlje* pZaglavlje;
+	Indeks* indeks; // nullptr ako skup nije indeksiran
+	Bazen<Element> bazen;
+
+	void kopiraj(const DCLLSkup& s);
+	void premesti(DCLLSkup& s);
+	void obrisi();
+
+	inline void inicijalizuj(bool indeksiran);
+
+	inline void azurirajZaglavlje(Operacija op);
+
+	inline Element* dodajNakon(Element *p, int k);
+	inline Element* dodajPre(Element *p, int k);
+	inline void izbaci(Element *p);
+
+	Element* prviNeManjiOd(int k) const;
+
+	void pisi(ostream& o) const override;
+
+	template <class F>
+	void spajanje(const DCLLSkup& drugi, int delovi, F f) const;
+
+	DCLLSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	DCLLSkup* prazan() const override;
+
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	explicit DCLLSkup(bool indeksiran = false) { inicijalizuj(indeksiran); }
+	DCLLSkup(const DCLLSkup& s) { kopiraj(s); }
+	DCLLSkup(DCLLSkup&& ss) { premesti(ss); }
+	~DCLLSkup() override { obrisi(); }
+
+	DCLLSkup& operator=(const DCLLSkup& s);
+	DCLLSkup& operator=(DCLLSkup&& s);
+
+	bool Indeksiran() const { return indeks != nullptr; }
+
+	bool PostojanjeElementa(int k) const override;
+	DCLLSkup& UmetniElement(int k) override;
+	DCLLSkup& UmetniElemente(const int* niz, int broj) override;
+
+	DCLLSkup& ObrisiElement(int k) override;
+	DCLLSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override;
+
+	void IsprazniSkup() override;
+
+	DCLLSkup* Razlika(const Skup& s2) const;
+	DCLLSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	// iterator prati pokazivace liste u oba smera, a kraj je zaglavlje
+	class Iterator
+	{
+		const Element* p;
+
+	public:
+		typedef bidirectional_iterator_tag iterator_category;
+		typedef int value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const int* pointer;
+		typedef const int& reference;
+
+		Iterator(const Element* _p = nullptr) :p(_p) {}
+
+		const int& operator*() const { return p->broj; }
+		const int* operator->() const { return &p->broj; }
+
+		Iterator& operator++() { p = p->sledeci; return *this; }
+		Iterator& operator--() { p = p->prethodni; return *this; }
+		Iterator operator++(int) { Iterator i = *this; p = p->sledeci; return i; }
+		Iterator operator--(int) { Iterator i = *this; p = p->prethodni; return i; }
+
+		bool operator==(const Iterator& i) const { return p == i.p; }
+		bool operator!=(const Iterator& i) const { return p != i.p; }
+	};
+
+	Iterator begin() const { return Iterator(pZaglavlje->sledeci); }
+	Iterator end() const { return Iterator(pZaglavlje); }
+	Iterator lower_bound(int k) const { return Iterator(prviNeManjiOd(k)); }
+	Iterator upper_bound(int k) const { return k == INT_MAX ? end() : Iterator(prviNeManjiOd(k + 1)); }
+
+	StatistikaAlokacije StatistikaAlokatora() const override;
+
+};
+
+// zajednicki prolaz kroz dve liste; f se poziva za kljuceve iz zadatih delova i vraca false za prekid
+template <class F>
+void DCLLSkup::spajanje(const DCLLSkup & drugi, int delovi, F f) const
+{
+	const Element* p1 = pZaglavlje->sledeci;
+	const Element* p2 = drugi.pZaglavlje->sledeci;
+
+	while (true)
+	{
+		bool kraj1 = p1 == pZaglavlje, kraj2 = p2 == drugi.pZaglavlje;
+
+		if (kraj1 && (kraj2 || (delovi & SAMO_DRUGI) == 0))
+			return;
+		if (kraj2 && (delovi & SAMO_PRVI) == 0)
+			return;
+
+		int deo, k;
+
+		if (kraj2 || (!kraj1 && p1->broj < p2->broj))
+		{
+			deo = SAMO_PRVI;
+			k = p1->broj;
+			p1 = p1->sledeci;
+		}
+		else if (kraj1 || p2->broj < p1->broj)
+		{
+			deo = SAMO_DRUGI;
+			k = p2->broj;
+			p2 = p2->sledeci;
+		}
+		else
+		{
+			deo = OBA;
+			k = p1->broj;
+			p1 = p1->sledeci;
+			p2 = p2->sledeci;
+		}
+
+		if ((delovi & deo) != 0 && !f(k))
+			return;
+	}
+}
+
+#pragma endregion
+
+#pragma region "AVLSkup.h"
+
+// samobalansirajuce binarno stablo pretrazivanja - visine podstabala svakog cvora se razlikuju najvise za 1
+class AVLSkup : public Skup
+{
+
+private:
+	class Cvor
+	{
+	public:
+		int kljuc;
+		int visina;
+		Cvor* levi;
+		Cvor* desni;
+
+		Cvor(int _kljuc, Cvor* _levi = nullptr, Cvor* _desni = nullptr) :kljuc(_kljuc), visina(1), levi(_levi), desni(_desni) {}
+	};
+
+	Cvor* koren;
+	int n;
+	Bazen<Cvor> bazen;
+
+	void kopiraj(const AVLSkup& s);
+	void premesti(AVLSkup& s);
+	void obrisi();
+
+	Cvor* kopirajPodstablo(const Cvor* p);
+
+	static inline int visina(const Cvor* p) { return p != nullptr ? p->visina : 0; }
+	static inline void azurirajVisinu(Cvor* p);
+	static Cvor* rotirajLevo(Cvor* p);
+	static Cvor* rotirajDesno(Cvor* p);
+	static Cvor* balansiraj(Cvor* p);
+
+	Cvor* umetni(Cvor* p, int k, bool& umetnut);
+	Cvor* izbaci(Cvor* p, int k, bool& izbacen);
+	static Cvor* izbaciMinimum(Cvor* p, Cvor*& minimum);
+
+	Cvor* izgradi(const int* niz, int od, int doo);
+	static Cvor* izListe(Cvor*& lista, int broj);
+
+	void pisi(ostream& o) const override;
+
+	template <class F>
+	void spajanje(const AVLSkup& drugi, int delovi, F f) const;
+
+	AVLSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	AVLSkup* prazan() const override;
+
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	AVLSkup() : koren(nullptr), n(0) {}
+	AVLSkup(const AVLSkup& s) : koren(nullptr), n(0) { kopiraj(s); }
+	AVLSkup(AVLSkup&& ss) : koren(nullptr), n(0) { premesti(ss); }
+	~AVLSkup() override { obrisi(); }
+
+	AVLSkup& operator=(const AVLSkup& s);
+	AVLSkup& operator=(AVLSkup&& s);
+
+	bool PostojanjeElementa(int k) const override;
+	void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const override;
+	AVLSkup& UmetniElement(int k) override;
+	AVLSkup& UmetniElemente(const int* niz, int broj) override;
+
+	AVLSkup& ObrisiElement(int k) override;
+	AVLSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override { return n; }
+
+	void IsprazniSkup() override;
+
+	AVLSkup* Razlika(const Skup& s2) const;
+	AVLSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	// konkretni iteratori (bez virtuelnih poziva) zaklanjaju one iz Skup
+	typedef IteratorStabla<Cvor> Iterator;
+
+	Iterator begin() const { return Iterator::NeManjiOd(koren, INT_MIN); }
+	Iterator end() const { return Iterator(koren); }
+	Iterator lower_bound(int k) const { return Iterator::NeManjiOd(koren, k); }
+	Iterator upper_bound(int k) const { return Iterator::VeciOd(koren, k); }
+
+	StatistikaAlokacije StatistikaAlokatora() const override { return bazen.Statistika(); }
+};
+
+// zajednicki inorder obilazak dva stabla; f vraca false kada spajanje treba prekinuti
+template <class F>
+void AVLSkup::spajanje(const AVLSkup & drugi, int delovi, F f) const
+{
+	KursorStabla<Cvor> a(koren), b(drugi.koren);
+	spajanjeKursora(a, b, delovi, f);
+}
+
+#pragma endregion
+
+#pragma region "JezgraNiza.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JEZGRA_X86 // vektorska jezgra se prevode uz target atribut, a biraju pri izvrsavanju
+#endif
+
+/* jezgra nad sortiranim nizovima kljuceva bez ponavljanja (NizSkup): pretraga i spajanje za
+razliku i presek. Skalarna verzija nema grananja koja zavise od kljuceva, a SSE4 i AVX2 verzije
+porede po 4, odnosno 8 kljuceva svakog niza odjednom (svaki sa svakim) i sabijaju pogotke
+tabelom permutacija. Pri prvoj upotrebi se bira najbolja verzija koju procesor podrzava */
+struct JezgraNiza
+{
+	const char* naziv;
+
+	// prvi indeks u a[0..n) ciji element nije manji od k
+	size_t (*NeManjiOd)(const int* a, size_t n, int k);
+
+	// vracaju broj upisanih kljuceva; izlaz razlike mora imati mesta za na elemenata i sme biti
+	// sam niz a, a izlaz preseka za min(na, nb) + REZERVA jer se vektor upisuje ceo
+	size_t (*Razlika)(const int* a, size_t na, const int* b, size_t nb, int* izlaz);
+	size_t (*Presek)(const int* a, size_t na, const int* b, size_t nb, int* izlaz);
+
+	static const size_t REZERVA = 8;
+
+	static const JezgraNiza& Izabrana();
+	// nullptr ako verzija ne postoji ili je procesor ne podrzava
+	static const JezgraNiza* PoNazivu(const string& naziv);
+	static void Izaberi(const JezgraNiza& j);
+
+private:
+	static const JezgraNiza*& izabrana();
+	static const JezgraNiza& najbolja();
+};
+
+#pragma endregion
+
+#pragma region "NizSkup.h"
+
+// skup predstavljen sortiranim nizom u kontinualnoj memoriji (flat set)
+class NizSkup : public Skup
+{
+
+private:
+	// umetanja se skupljaju u seriju koja se sortira i spaja sa nizom tek kada naraste
+	// do velicine samog niza ili kada je potrebno citanje, pa je formiranje O(n log n)
+	static const size_t MIN_SERIJA = 1024;
+
+	mutable vector<int> elementi;	// sortirani, bez ponavljanja
+	mutable vector<int> naCekanju;	// nesortirana serija umetanja
+
+	void spoji() const;
+
+	// prvi element od pozicije od koji nije manji od k - eksponencijalna, pa binarna pretraga
+	static size_t galopiraj(const vector<int>& niz, size_t od, int k);
+	// isto, jezgrom niza u [od, doo)
+	static size_t neManjiOd(const vector<int>& niz, int k, size_t od = 0)
+	{
+		BROJI_POREDJENJA(Instrumentacija::BrojKoraka(niz.size() - od));
+		return od + JezgraNiza::Izabrana().NeManjiOd(niz.data() + od, niz.size() - od, k);
+	}
+	static size_t veciOd(const vector<int>& niz, int k, size_t od = 0) { return k == INT_MAX ? niz.size() : neManjiOd(niz, k + 1, od); }
+
+	class Kursor : public Skup::Kursor
+	{
+		const vector<int>& elementi;
+		size_t i;
+
+	public:
+		Kursor(const vector<int>& _elementi) :elementi(_elementi), i(0) {}
+
+		bool Vazeci() const override { return i < elementi.size(); }
+		int Kljuc() const override { return elementi[i]; }
+		void Sledeci() override { i++; }
+		void Trazi(int k) override { i = galopiraj(elementi, i, k); }
+	};
+
+	void pisi(ostream& o) const override;
+
+	template <class F>
+	void spajanje(const NizSkup& drugi, int delovi, F f) const;
+
+	NizSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	NizSkup* prazan() const override;
+	int kvantil(int i, int delova) const override;
+
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	NizSkup() {}
+	NizSkup(const NizSkup& s) = default;
+	NizSkup(NizSkup&& s) = default;
+	~NizSkup() override {}
+
+	NizSkup& operator=(const NizSkup& s) = default;
+	NizSkup& operator=(NizSkup&& s) = default;
+
+	bool PostojanjeElementa(int k) const override;
+	void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const override;
+	NizSkup& UmetniElement(int k) override;
+	NizSkup& UmetniElemente(const int* niz, int broj) override;
+
+	NizSkup& ObrisiElement(int k) override;
+	NizSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override;
+
+	void IsprazniSkup() override;
+
+	NizSkup* Razlika(const Skup& s2) const;
+	NizSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	int BrojUOpsegu(int min, int max) const override;
+};
+
+// spajanje dva sortirana niza; oba moraju biti spojena sa serijom na cekanju pre poziva
+template <class F>
+void NizSkup::spajanje(const NizSkup & drugi, int delovi, F f) const
+{
+	const vector<int>& a = elementi;
+	const vector<int>& b = drugi.elementi;
+	size_t i = 0, j = 0;
+
+	while (true)
+	{
+		bool kraj1 = i == a.size(), kraj2 = j == b.size();
+
+		if (kraj1 && (kraj2 || (delovi & SAMO_DRUGI) == 0))
+			return;
+		if (kraj2 && (delovi & SAMO_PRVI) == 0)
+			return;
+
+		int deo, k;
+
+		if (kraj2 || (!kraj1 && a[i] < b[j]))
+		{
+			deo = SAMO_PRVI;
+			k = a[i++];
+		}
+		else if (kraj1 || b[j] < a[i])
+		{
+			deo = SAMO_DRUGI;
+			k = b[j++];
+		}
+		else
+		{
+			deo = OBA;
+			k = a[i++];
+			j++;
+		}
+
+		if ((delovi & deo) != 0 && !f(k))
+			return;
+	}
+}
+
+#pragma endregion
+
+#pragma region "BitmapSkup.h"
+
+/* kompresovana bitmapa (po uzoru na roaring): 32-bitni kljuc se deli na gornjih 16 bitova,
+koji biraju kontejner, i donjih 16 bitova koji se cuvaju u kontejneru kao sortirani niz,
+bitmapa od 2^16 bitova ili niz intervala - u zavisnosti od toga sta zauzima najmanje memorije */
+class BitmapSkup : public Skup
+{
+
+private:
+	class Kontejner
+	{
+	public:
+		enum Tip { NIZ, BITMAPA, INTERVALI };
+
+		static const int MAKS_NIZ = 4096;	// iznad ovoga bitmapa (8 KB) zauzima manje od niza
+		static const int MIN_BITMAPA = MAKS_NIZ / 2; // bitmapa se vraca u niz tek ispod ovoga, da kontejner na granici ne bi stalno menjao oblik
+		static const int BROJ_RECI = 1024;	// 1024 * 64 = 2^16 bitova
+
+		struct Interval
+		{
+			uint16_t pocetak, kraj; // oba ukljucena
+		};
+
+		uint16_t kljuc;	// gornjih 16 bitova svih elemenata kontejnera
+		Tip tip;
+		int broj;		// broj elemenata kontejnera
+
+		vector<uint16_t> niz;		// NIZ: sortirane vrednosti
+		vector<uint64_t> reci;		// BITMAPA: BROJ_RECI reci
+		vector<Interval> intervali;	// INTERVALI: sortirani, disjunktni i nesusedni
+
+		Kontejner(uint16_t _kljuc) :kljuc(_kljuc), tip(NIZ), broj(0) {}
+
+		bool Sadrzi(uint16_t v) const;
+		bool Dodaj(uint16_t v);
+		bool Ukloni(uint16_t v);
+		int UkloniOpseg(uint16_t od, uint16_t doo);
+		int DodajSortirane(const uint16_t* vrednosti, int koliko); // vraca broj novih elemenata
+		int SledeciOd(int v) const; // najmanja vrednost koja nije manja od v, ili -1
+		int PrethodniOd(int v) const; // najveca vrednost koja nije veca od v, ili -1
+		int BrojUOpsegu(int od, int doo) const; // broj vrednosti u [od, doo]
+
+		void Optimizuj();
+
+		template <class F>
+		void ZaSvaki(F f) const;
+
+		static Kontejner Spoji(const Kontejner& a, const Kontejner& b, int delovi);
+		static int BrojZajednickih(const Kontejner& a, const Kontejner& b);
+
+	private:
+		static inline int brojBitova(uint64_t w);
+		static inline int nulaNaKraju(uint64_t w);
+		static inline int nulaNaPocetku(uint64_t w);
+		static void postaviBitove(vector<uint64_t>& reci, int od, int doo);
+		static int obrisiBitove(vector<uint64_t>& reci, int od, int doo);
+
+		int brojIntervala() const;
+		void proveriIntervale();
+		void upisiReci(vector<uint64_t>& b) const;
+
+		void uBitmapu();
+		void uNiz();
+		void uIntervale();
+	};
+
+	class Kursor : public Skup::Kursor
+	{
+		const vector<Kontejner>& kontejneri;
+		size_t i;	// tekuci kontejner
+		int v;		// donjih 16 bitova tekuceg kljuca
+
+		void naPrvi() { v = i < kontejneri.size() ? kontejneri[i].SledeciOd(0) : -1; }
+
+	public:
+		Kursor(const vector<Kontejner>& _kontejneri) :kontejneri(_kontejneri), i(0) { naPrvi(); }
+
+		bool Vazeci() const override { return i < kontejneri.size(); }
+		int Kljuc() const override { return uOznacen((uint32_t)kontejneri[i].kljuc << 16 | v); }
+		void Sledeci() override;
+		void Trazi(int k) override;
+
+		uintptr_t Pozicija() const { return (uintptr_t)i << 16 | v; } // kao u BitmapSkup::pozicijaNeManjegOd
+	};
+
+	vector<Kontejner> kontejneri; // sortirani po kljucu
+	int n;
+
+	int pronadiKontejner(uint16_t kljuc) const;
+
+	void pisi(ostream& o) const override;
+
+	BitmapSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	BitmapSkup* prazan() const override;
+
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	BitmapSkup() : n(0) {}
+	BitmapSkup(const BitmapSkup& s) = default;
+	BitmapSkup(BitmapSkup&& s) = default;
+	~BitmapSkup() override {}
+
+	BitmapSkup& operator=(const BitmapSkup& s) = default;
+	BitmapSkup& operator=(BitmapSkup&& s) = default;
+
+	bool PostojanjeElementa(int k) const override;
+	void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const override;
+	BitmapSkup& UmetniElement(int k) override;
+	BitmapSkup& UmetniElemente(const int* niz, int broj) override;
+
+	BitmapSkup& ObrisiElement(int k) override;
+	BitmapSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override { return n; }
+
+	void IsprazniSkup() override;
+
+	BitmapSkup* Razlika(const Skup& s2) const;
+	BitmapSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	int BrojUOpsegu(int min, int max) const override;
+
+	// svaki kontejner prelazi u najkompaktniju reprezentaciju (npr. dugi nizovi uzastopnih kljuceva u intervale)
+	BitmapSkup& Optimizuj();
+};
+
+template <class F>
+void BitmapSkup::Kontejner::ZaSvaki(F f) const
+{
+	if (tip == NIZ)
+	{
+		for (uint16_t v : niz)
+			f(v);
+	}
+	else if (tip == BITMAPA)
+	{
+		for (int i = 0; i < BROJ_RECI; i++)
+		{
+			uint64_t w = reci[i];
+			while (w != 0)
+			{
+				f((uint16_t)(i * 64 + nulaNaKraju(w)));
+				w &= w - 1;
+			}
+		}
+	}
+	else
+	{
+		for (const Interval& in : intervali)
+			for (int v = in.pocetak; v <= in.kraj; v++)
+				f((uint16_t)v);
+	}
+}
+
+#pragma endregion
+
+#pragma region "KonkurentniSkup.h"
+
+/* skup koji se moze deliti izmedju niti: lenja skip lista (Herlihy, Lev, Luchangco, Shavit).
+PostojanjeElementa ne zakljucava nista i ne ceka ni na jednu nit, a UmetniElement i ObrisiElement
+zakljucavaju samo prethodnike na putu do kljuca, pa se pisci medjusobno cekaju samo u okolini
+istog kljuca. Brisanje je dvofazno: cvor se prvo oznaci (logicki izbaci), pa se izveze iz nivoa.
+Izvezeni cvorovi se oslobadjaju po epohama: svaka operacija (i svaki kursor, dok postoji) je
+prijavljena u epohi u kojoj je pocela, a cvor izvezen u epohi e se oslobadja kada epoha dodje do
+e + 2, sto je moguce tek kada se zavrse sve operacije prijavljene u e. Iteratori cuvaju kljuc, a
+ne cvor, pa ne drze epohu. Destruktor, IsprazniSkup, OslobodiPovucene, dodela i operacije nad
+celim skupovima (&=, |=, ^=, -=) zahtevaju da nijedna druga nit ne koristi skup */
+class KonkurentniSkup : public Skup
+{
+
+private:
+	static const int MAKS_NIVO = 16;
+	static const int TRAKA = 16;	// brojaci prijavljenih operacija, da niti ne dele jednu liniju kesa
+	static const int PRAG_CISCENJA = 64;	// broj izvozenja izmedju dva pokusaja pomeranja epohe
+
+	struct Cvor
+	{
+		int kljuc;
+		int nivo;
+		atomic<bool> oznacen;	// logicki izbacen
+		atomic<bool> povezan;	// povezan na svim nivoima - tek tada je kljuc u skupu
+		mutex brava;
+		atomic<Cvor*>* sledeci;	// po jedan pokazivac za svaki nivo
+		Cvor* sledeciPovucen;	// veza u listi izvezenih cvorova
+
+		Cvor(int _kljuc, int _nivo) :kljuc(_kljuc), nivo(_nivo), oznacen(false), povezan(false), sledeci(new atomic<Cvor*>[_nivo]()), sledeciPovucen(nullptr) {}
+		~Cvor() { delete[] sledeci; }
+
+		bool Vazeci() const { return povezan.load(memory_order_acquire) && !oznacen.load(memory_order_acquire); }
+	};
+
+	struct alignas(64) Traka
+	{
+		atomic<int> prijavljenih[2]; // po parnosti epohe
+	};
+
+	// prijava operacije u tekucoj epohi, od konstrukcije do unistenja
+	class Zastita
+	{
+		atomic<int>* brojac;
+
+	public:
+		Zastita(const KonkurentniSkup& skup);
+		~Zastita() { brojac->fetch_sub(1, memory_order_release); }
+
+		Zastita(const Zastita&) = delete;
+		Zastita& operator=(const Zastita&) = delete;
+	};
+
+	// kursor prati nivo 0 i preskace cvorove koji nisu u skupu - vidi stanje slabo konzistentno
+	class Kursor : public Skup::Kursor
+	{
+		const KonkurentniSkup* skup;
+		Zastita zastita; // cvor na kome kursor stoji ne sme biti oslobodjen
+		const Cvor* tekuci;
+
+	public:
+		Kursor(const KonkurentniSkup* _skup) :skup(_skup), zastita(*_skup), tekuci(_skup->neManjiOd(INT_MIN)) {}
+
+		bool Vazeci() const override { return tekuci != nullptr; }
+		int Kljuc() const override { return tekuci->kljuc; }
+		void Sledeci() override { tekuci = skup->sledeciVazeci(tekuci); }
+		void Trazi(int k) override { if (tekuci != nullptr && tekuci->kljuc < k) tekuci = skup->neManjiOd(k); }
+	};
+
+	Cvor* glava; // kljuc glave se ne koristi, a kraj svakog nivoa je nullptr
+	atomic<int> n;
+
+	mutable Traka trake[TRAKA];
+	atomic<uint64_t> epoha;
+	atomic<Cvor*> povuceni[2];	// izvezeni cvorovi po parnosti epohe izvozenja
+	atomic<int> doCiscenja;
+	mutex ciscenje;			// epohu pomera jedna nit
+
+	void inicijalizuj();
+	void kopiraj(const KonkurentniSkup& s);
+	void premesti(KonkurentniSkup& s);
+	void obrisi();
+
+	static int slucajanNivo();
+	int pronadji(int k, Cvor** prethodnici, Cvor** sledbenici) const;
+	static void otkljucaj(Cvor** prethodnici, int doNivoa);
+	void povuci(Cvor* p);
+	void pomeriEpohu();
+	static void oslobodi(Cvor* p);
+	static int traka();
+
+	const Cvor* neManjiOd(int k) const;
+	const Cvor* sledeciVazeci(const Cvor* p) const;
+	const Cvor* poslednjiManjiOd(int k, bool bezGranice) const;
+
+	void pisi(ostream& o) const override;
+
+	KonkurentniSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	KonkurentniSkup* prazan() const override;
+
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	KonkurentniSkup() { inicijalizuj(); }
+	KonkurentniSkup(const KonkurentniSkup& s) { inicijalizuj(); kopiraj(s); }
+	KonkurentniSkup(KonkurentniSkup&& s) { inicijalizuj(); premesti(s); }
+	~KonkurentniSkup() override;
+
+	KonkurentniSkup& operator=(const KonkurentniSkup& s);
+	KonkurentniSkup& operator=(KonkurentniSkup&& s);
+
+	bool PostojanjeElementa(int k) const override;
+	KonkurentniSkup& UmetniElement(int k) override;
+
+	KonkurentniSkup& ObrisiElement(int k) override;
+	KonkurentniSkup& ObrisiOpsegVrednosti(int min, int max) override; // svaki kljuc opsega se brise zasebno
+
+	int BrojElemenata() const override { return n.load(memory_order_relaxed); }
+
+	void IsprazniSkup() override;
+
+	KonkurentniSkup* Razlika(const Skup& s2) const;
+	KonkurentniSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	// oslobadja sve izvezene cvorove odmah - samo kada nijedna druga nit ne koristi skup
+	void OslobodiPovucene();
+};
+
+#pragma endregion
+
+#pragma region "ParticionisaniSkup.h"
+
+/* skup podeljen po opsezima kljuceva na particije, od kojih je svaka zaseban skup zadate vrste
+sa svojom bravom: operacije nad jednim kljucem zakljucavaju samo njegovu particiju, pa se
+umetanja i brisanja u razlicitim particijama izvrsavaju paralelno, a broj elemenata se sabira
+iz brojaca particija bez zakljucavanja. Serije i operacije nad dva skupa iste podele rade
+particiju po particiju u zajednickom bazenu niti. Obilazak (kursor, iterator, ispis) i
+operacije nad celim skupom ne zakljucavaju, pa se ne smeju preklapati sa izmenama iz drugih niti */
+class ParticionisaniSkup : public Skup
+{
+
+private:
+	struct alignas(64) Particija // svaka u svojoj liniji kesa, da se brave i brojaci ne ometaju
+	{
+		unique_ptr<Skup> skup;
+		mutex brava;
+		atomic<int> broj;
+
+		Particija(Skup* _skup) :skup(_skup), broj(0) {}
+	};
+
+	// nadovezuje kursore particija redom
+	class Kursor : public Skup::Kursor
+	{
+		const ParticionisaniSkup* skup;
+		size_t i;
+		unique_ptr<Skup::Kursor> tekuci;
+
+		void naVazeci();
+
+	public:
+		Kursor(const ParticionisaniSkup* _skup);
+
+		bool Vazeci() const override { return i < skup->particije.size(); }
+		int Kljuc() const override { return tekuci->Kljuc(); }
+		void Sledeci() override { tekuci->Sledeci(); naVazeci(); }
+		void Trazi(int k) override;
+	};
+
+	int vrsta; // vrsta skupa u particijama (FabrikaSkupova::Vrsta)
+	vector<unique_ptr<Particija>> particije;
+
+	size_t particijaZa(int k) const { return (size_t)(((uint64_t)uNeoznacen(k) * particije.size()) >> 32); }
+	int najmanjiU(size_t i) const; // najmanji kljuc koji pripada particiji i
+
+	void napravi(int _vrsta, int brojParticija);
+	void kopiraj(const ParticionisaniSkup& s);
+
+	bool istaPodela(const ParticionisaniSkup& s) const { return vrsta == s.vrsta && particije.size() == s.particije.size(); }
+
+	void pisi(ostream& o) const override;
+
+	ParticionisaniSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	ParticionisaniSkup* prazan() const override;
+
+	// pozicija je neoznacen kljuc uvecan za 1, a kraj 0 - korak je pretraga u particiji, O(log n) za stabla i niz
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	// TIP ako vrsta particija ne postoji ili je i sama particionisana, INDEKS ako broj particija nije u [1, 1024]
+	explicit ParticionisaniSkup(int _vrsta, int brojParticija = 16) { napravi(_vrsta, brojParticija); }
+	ParticionisaniSkup(const ParticionisaniSkup& s) { kopiraj(s); }
+	ParticionisaniSkup(ParticionisaniSkup&& s) { napravi(s.vrsta, (int)s.particije.size()); particije.swap(s.particije); }
+	~ParticionisaniSkup() override {}
+
+	ParticionisaniSkup& operator=(const ParticionisaniSkup& s);
+	ParticionisaniSkup& operator=(ParticionisaniSkup&& s);
+
+	int BrojParticija() const { return (int)particije.size(); }
+
+	bool PostojanjeElementa(int k) const override;
+	void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const override;
+	ParticionisaniSkup& UmetniElement(int k) override;
+	ParticionisaniSkup& UmetniElemente(const int* niz, int broj) override;
+
+	ParticionisaniSkup& ObrisiElement(int k) override;
+	ParticionisaniSkup& ObrisiElemente(const int* niz, int broj) override;
+	ParticionisaniSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override;
+
+	void IsprazniSkup() override;
+
+	ParticionisaniSkup* Razlika(const Skup& s2) const;
+	ParticionisaniSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	int BrojUOpsegu(int min, int max) const override;
+};
+
+#pragma endregion
+
+#pragma region "Snimak.h"
+
+/* binarni snimak skupa: kljucevi se cuvaju sortirani, u blokovima od po KLJUCEVA_U_BLOKU.
+Direktorijum cuva prvi kljuc svakog bloka i pomak njegovih podataka, a ostali kljucevi bloka
+su razlike od prethodnog kljuca u varint kodu (7 bita po bajtu, najvisi bit znaci da sledi
+jos bajtova). Svi brojevi su little-endian:
+
+   zaglavlje (32 B): oznaka "DZSK", verzija, broj kljuceva, broj blokova, kljuceva u bloku,
+                     bajtova podataka i kontrolni zbir (FNV-1a, 64 bita) svega ostalog u snimku
+   direktorijum:     za svaki blok prvi kljuc (4 B) i pomak u podacima (4 B)
+   podaci:           razlike, blok za blokom
+
+Zbog direktorijuma se pojedinacni kljuc nalazi binarnom pretragom i dekodiranjem jednog bloka,
+bez citanja ostatka snimka (MapiraniSkup) */
+struct Snimak
+{
+	static const uint32_t OZNAKA = 0x4B535A44; // "DZSK"
+	static const uint32_t VERZIJA = 1;
+	static const uint32_t KLJUCEVA_U_BLOKU = 128;
+	static const size_t ZAGLAVLJE = 32;
+	static const size_t STAVKA_DIREKTORIJUMA = 8;
+
+	struct Zaglavlje
+	{
+		uint32_t broj;
+		uint32_t blokova;
+		uint32_t kljucevaUBloku;
+		uint32_t bajtova;
+		uint64_t kontrolniZbir;
+	};
+
+	static inline uint32_t Citaj32(const unsigned char* p) { return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24; }
+	static inline void Upisi32(unsigned char* p, uint32_t v) { p[0] = (unsigned char)v; p[1] = (unsigned char)(v >> 8); p[2] = (unsigned char)(v >> 16); p[3] = (unsigned char)(v >> 24); }
+
+	static inline void UpisiVarint(vector<unsigned char>& izlaz, uint32_t v);
+	// nullptr ako kod prelazi kraj
+	static inline const unsigned char* CitajVarint(const unsigned char* p, const unsigned char* kraj, uint32_t& v);
+
+	// zbir zaglavlja bez polja zbira, direktorijuma i podataka
+	static uint64_t KontrolniZbir(const unsigned char* p, size_t velicina);
+
+	// ceo snimak skupa (zaglavlje, direktorijum i podaci)
+	static void Kodiraj(const Skup& s, vector<unsigned char>& izlaz);
+
+	// sve provere bacaju Skup::FORMAT
+	static Zaglavlje CitajZaglavlje(const unsigned char* p);
+	static size_t Velicina(const Zaglavlje& z) { return ZAGLAVLJE + (size_t)z.blokova * STAVKA_DIREKTORIJUMA + z.bajtova; }
+	// zaglavlje, duzina i poredak direktorijuma; kontrolni zbir samo ako se trazi jer se za njega cita ceo snimak
+	static Zaglavlje Proveri(const unsigned char* p, size_t n, bool kontrolniZbir);
+	// svi kljucevi redom, uz proveru da su podaci blokova ispravni i strogo rastuci
+	static void Dekodiraj(const unsigned char* p, const Zaglavlje& z, vector<int>& kljucevi);
+};
+
+inline void Snimak::UpisiVarint(vector<unsigned char>& izlaz, uint32_t v)
+{
+	while (v >= 0x80)
+	{
+		izlaz.push_back((unsigned char)(v | 0x80));
+		v >>= 7;
+	}
+
+	izlaz.push_back((unsigned char)v);
+}
+
+inline const unsigned char * Snimak::CitajVarint(const unsigned char * p, const unsigned char * kraj, uint32_t & v)
+{
+	v = 0;
+	for (int pomeraj = 0; p < kraj && pomeraj < 35; pomeraj += 7)
+	{
+		unsigned char b = *p++;
+		v |= (uint32_t)(b & 0x7F) << pomeraj;
+
+		if ((b & 0x80) == 0)
+			return p;
+	}
+
+	return nullptr;
+}
+
+#pragma endregion
+
+#pragma region "MapiraniSkup.h"
+
+/* skup samo za citanje nad binarnim snimkom mapiranim u memoriju (mmap): pri otvaranju se
+nista ne dekodira, PostojanjeElementa binarno pretrazuje direktorijum i dekodira najvise jedan
+blok, a stranice snimka operativni sistem ucitava tek kad se procitaju. Izmene bacaju
+SAMO_ZA_CITANJE, a rezultati operacija nad dva skupa su NizSkup. Bez mmap-a (van POSIX
+sistema) se snimak cita u memoriju, ali se ni tada ne dekodira */
+class MapiraniSkup : public Skup
+{
+
+private:
+	/* redom kroz kljuceve jednog bloka; bez kontrolnog zbira podaci blokova nisu provereni, pa
+	svaki kljuc mora biti veci od prethodnog i manji od prvog kljuca sledeceg bloka (FORMAT) -
+	inace bi blokZa za njega vratio drugi blok i obilazak se mogao vrteti u krug */
+	struct CitacBloka
+	{
+		const unsigned char* p; // sledeca razlika
+		const unsigned char* kraj;
+		uint32_t kljuc;
+		int64_t granica; // prvi kljuc sledeceg bloka, ili INT_MAX + 1
+
+		bool Sledeci()
+		{
+			uint32_t razlika;
+			const unsigned char* q = Snimak::CitajVarint(p, kraj, razlika);
+			if (q == nullptr)
+				return false;
+			if (razlika == 0 || (int)kljuc + (int64_t)razlika >= granica)
+				throw FORMAT;
+
+			p = q;
+			kljuc += razlika;
+			return true;
+		}
+	};
+
+	class Kursor : public Skup::Kursor
+	{
+		const MapiraniSkup* skup;
+		size_t blok;
+		CitacBloka citac;
+
+	public:
+		Kursor(const MapiraniSkup* _skup);
+
+		bool Vazeci() const override { return blok < skup->zaglavlje.blokova; }
+		int Kljuc() const override { return (int)citac.kljuc; }
+		void Sledeci() override;
+		void Trazi(int k) override;
+	};
+
+	const unsigned char* snimak;
+	size_t velicina;
+	vector<unsigned char> bafer; // snimak procitan u memoriju kada mmap nije podrzan
+
+	Snimak::Zaglavlje zaglavlje;
+	const unsigned char* direktorijum;
+	const unsigned char* podaci;
+
+	void mapiraj(const string& datoteka);
+	void odmapiraj();
+
+	int prviU(size_t b) const { return (int)Snimak::Citaj32(direktorijum + b * Snimak::STAVKA_DIREKTORIJUMA); }
+	uint32_t pomakU(size_t b) const { return Snimak::Citaj32(direktorijum + b * Snimak::STAVKA_DIREKTORIJUMA + 4); }
+	uint32_t krajBloka(size_t b) const { return b + 1 < zaglavlje.blokova ? pomakU(b + 1) : zaglavlje.bajtova; }
+	int64_t granicaBloka(size_t b) const { return b + 1 < zaglavlje.blokova ? prviU(b + 1) : (int64_t)INT_MAX + 1; }
+	CitacBloka citacBloka(size_t b) const { return { podaci + pomakU(b), podaci + krajBloka(b), (uint32_t)prviU(b), granicaBloka(b) }; }
+
+	long blokZa(int k) const; // poslednji blok ciji prvi kljuc nije veci od k, -1 ako takvog nema
+	int brojNeVecihOd(int k) const;
+
+	void pisi(ostream& o) const override;
+
+	Skup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	Skup* prazan() const override;
+
+	// pozicija je (pomak iza kljuca u podacima + 1) << 32 | kljuc, a kraj 0; korak je pretraga direktorijuma
+	uintptr_t pozicija(const CitacBloka& c) const { return (uintptr_t)((uint64_t)(c.p - podaci + 1) << 32 | c.kljuc); }
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	// FORMAT ako datoteka ne moze da se procita ili nije ispravan snimak
+	explicit MapiraniSkup(const string& datoteka, bool proveriZbir = true);
+	MapiraniSkup(const MapiraniSkup&) = delete;
+	MapiraniSkup& operator=(const MapiraniSkup&) = delete;
+	~MapiraniSkup() override { odmapiraj(); }
+
+	bool PostojanjeElementa(int k) const override;
+
+	// izmene bacaju SAMO_ZA_CITANJE
+	MapiraniSkup& UmetniElement(int k) override;
+	MapiraniSkup& UmetniElemente(const int* niz, int broj) override;
+	MapiraniSkup& ObrisiElement(int k) override;
+	MapiraniSkup& ObrisiOpsegVrednosti(int min, int max) override;
+	void IsprazniSkup() override;
+	MapiraniSkup& RazlikaUMestu(const Skup& s2) override;
+
+	int BrojElemenata() const override { return (int)zaglavlje.broj; }
+
+	Skup* Razlika(const Skup& s2) const override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	int BrojUOpsegu(int min, int max) const override;
+};
+
+#pragma endregion
+
+#pragma region "HashSkup.h"
+
+/* neuredjen skup sa otvorenim adresiranjem u stilu Swiss tabele: mesta su podeljena u grupe od 16,
+a kontrolni bajt svakog mesta cuva 7 bita hesa kljuca ili oznaku praznog/obrisanog mesta, pa se
+cela grupa proverava jednim SSE2 poredjenjem. Tabela se povecava postepeno: stara ostaje dok je
+izmene ne premeste grupu po grupu, a pretraga za to vreme gleda obe, pa nijedna izmena ne premesta
+ceo skup odjednom. Operacije koje traze poredak (kursor, iterator, ispis) rade nad sortiranom
+kopijom kljuceva koja se pravi pri prvoj takvoj operaciji posle izmene */
+class HashSkup : public Skup
+{
+
+private:
+	static const size_t GRUPA = 16;
+	// puno mesto ima 1 u najvisem bitu, a prazno je 0 da bi nova tabela mogla da se dobije od calloc-a,
+	// cije stranice sistem nulira tek pri prvom pristupu - povecanje tako ne prolazi kroz celu tabelu
+	static const uint8_t PRAZNO = 0x00;
+	static const uint8_t OBRISANO = 0x01;
+	static const size_t KORAK_PREMESTANJA = 2;	// grupa stare tabele koje se premestaju pri svakoj izmeni
+
+	struct OslobodiC
+	{
+		void operator()(void* p) const { free(p); }
+	};
+
+	struct Tabela
+	{
+		size_t grupa; // broj grupa, stepen dvojke (0 dok tabela nije napravljena)
+		unique_ptr<uint8_t[], OslobodiC> kontrola;
+		unique_ptr<int[]> kljucevi;
+		size_t punih;
+		size_t obrisanih;
+
+		Tabela(size_t _grupa = 0);
+		Tabela(const Tabela& t);
+		Tabela(Tabela&& t) = default;
+		Tabela& operator=(Tabela&& t) = default;
+
+		size_t Kapacitet() const { return grupa * GRUPA; }
+		// najvise 7/8 mesta sme biti zauzeto (punih ili obrisanih), da bi probe ostale kratke
+		bool Puna() const { return punih + obrisanih >= Kapacitet() / 8 * 7; }
+
+		long Nadji(int k, uint64_t h) const; // mesto kljuca, -1 ako ga nema
+		void Umetni(int k, uint64_t h);	// kljuc ne sme vec biti u tabeli
+		void Obrisi(size_t mesto);
+
+		// f vraca false za prekid obilaska, a tada i ZaSvakiDok vraca false
+		template <class F>
+		bool ZaSvakiDok(F f) const;
+		template <class F>
+		void ZaSvaki(F f) const { ZaSvakiDok([&f](int k) { f(k); return true; }); }
+	};
+
+	class Kursor : public Skup::Kursor
+	{
+		const vector<int>& poredak;
+		size_t i;
+
+	public:
+		Kursor(const vector<int>& _poredak) :poredak(_poredak), i(0) {}
+
+		bool Vazeci() const override { return i < poredak.size(); }
+		int Kljuc() const override { return poredak[i]; }
+		void Sledeci() override { i++; }
+		void Trazi(int k) override { i += JezgraNiza::Izabrana().NeManjiOd(poredak.data() + i, poredak.size() - i, k); }
+	};
+
+	Tabela tekuca;
+	Tabela stara;		// tabela koja se premesta u tekucu (grupa 0 ako premestanja nema)
+	size_t premesteno;	// broj premestenih grupa stare tabele
+
+	mutable vector<int> poredak; // sortirani kljucevi, vazi samo ako je uredjen
+	mutable bool uredjen;
+
+	static inline uint64_t hes(int k);
+	static inline uint32_t poklapanja(const uint8_t* grupa, uint8_t bajt);
+	static inline uint32_t puna(const uint8_t* grupa);
+	static inline int nulaNaKraju(uint32_t m);
+
+	void premestiKorak();
+	void zavrsiPremestanje();
+	void pripremiUmetanje();
+	void izmenjen() { uredjen = false; }
+	void urediPoredak() const;
+
+	template <class F>
+	bool zaSvakiDok(F f) const;
+	template <class F>
+	static bool zaSvakiUDok(const Skup& s, F f); // bez poretka za HashSkup, kursorom za ostale
+	template <class F>
+	void zaSvaki(F f) const { zaSvakiDok([&f](int k) { f(k); return true; }); }
+	template <class F>
+	static void zaSvakiU(const Skup& s, F f) { zaSvakiUDok(s, [&f](int k) { f(k); return true; }); }
+
+	void pisi(ostream& o) const override;
+
+	Skup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	HashSkup* prazan() const override;
+
+	int kvantil(int i, int delova) const override;
+
+	// pozicija je indeks u sortiranoj kopiji
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	HashSkup() :premesteno(0), uredjen(true) {}
+	HashSkup(const HashSkup& s) = default;
+	HashSkup(HashSkup&& s);
+	~HashSkup() override {}
+
+	HashSkup& operator=(const HashSkup& s);
+	HashSkup& operator=(HashSkup&& s);
+
+	bool PostojanjeElementa(int k) const override;
+	void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const override;
+	HashSkup& UmetniElement(int k) override;
+
+	HashSkup& ObrisiElement(int k) override;
+	HashSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override { return (int)(tekuca.punih + stara.punih); }
+
+	void IsprazniSkup() override;
+
+	HashSkup* Razlika(const Skup& s2) const;
+	HashSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	int BrojUOpsegu(int min, int max) const override;
+};
+
+template <class F>
+bool HashSkup::Tabela::ZaSvakiDok(F f) const
+{
+	for (size_t g = 0; g < grupa; g++)
+		for (uint32_t m = puna(kontrola.get() + g * GRUPA); m != 0; m &= m - 1)
+			if (!f(kljucevi[g * GRUPA + nulaNaKraju(m)]))
+				return false;
+
+	return true;
+}
+
+template <class F>
+bool HashSkup::zaSvakiDok(F f) const
+{
+	return stara.ZaSvakiDok(f) && tekuca.ZaSvakiDok(f);
+}
+
+template <class F>
+bool HashSkup::zaSvakiUDok(const Skup & s, F f)
+{
+	const HashSkup* h = dynamic_cast<const HashSkup*>(&s);
+	if (h != nullptr)
+		return h->zaSvakiDok(f);
+
+	for (unique_ptr<Skup::Kursor> c = s.NapraviKursor(); c->Vazeci(); c->Sledeci())
+		if (!f(c->Kljuc()))
+			return false;
+
+	return true;
+}
+
+#pragma endregion
+
+#pragma region "BPlusSkup.h"
+
+/* B+ stablo: kljucevi su samo u listovima, koji su povezani u listu radi obilaska redom, a
+unutrasnji cvorovi cuvaju razdelnike i pokazivace na decu. GRANANJE je najveci broj dece
+unutrasnjeg cvora; za 16 razdelnici cvora staju u jednu liniju kesa, a list (3 * GRANANJE - 5
+kljuceva) zauzima isto koliko i unutrasnji cvor. Cvorovi su poravnati na liniju kesa, pa
+pretraga kroz 10M kljuceva cita oko 6 nivoa po dve linije, umesto 24+ cvorova binarnog stabla */
+template <int GRANANJE = 16>
+class BPlusSkup : public Skup
+{
+	static_assert(GRANANJE >= 4, "grananje B+ stabla mora biti bar 4");
+
+private:
+	static const int U_CVORU = GRANANJE - 1;		// najvise razdelnika u unutrasnjem cvoru
+	static const int U_LISTU = 3 * GRANANJE - 5;	// najvise kljuceva u listu
+	static const int MIN_U_CVORU = U_CVORU / 2;	// najmanje popunjenosti vaze za sve osim korena
+	static const int MIN_U_LISTU = U_LISTU / 2;
+
+	struct alignas(64) List
+	{
+		int kljucevi[U_LISTU];
+		int broj;
+		List* prethodni;
+		List* sledeci;
+	};
+
+	// u podstablu deca[i] su kljucevi iz [kljucevi[i - 1], kljucevi[i])
+	struct alignas(64) Cvor
+	{
+		int kljucevi[U_CVORU];
+		int broj; // broj razdelnika; dece ima jedno vise
+		void* deca[GRANANJE]; // listovi ako je cvor na nivou 1, inace unutrasnji cvorovi
+	};
+
+	class Kursor final : public Skup::Kursor
+	{
+		const BPlusSkup* skup;
+		const List* l;
+		int i;
+
+	public:
+		Kursor(const BPlusSkup* _skup) :skup(_skup), l(_skup->prvi), i(0) {}
+
+		bool Vazeci() const override { return l != nullptr; }
+		int Kljuc() const override { return l->kljucevi[i]; }
+		void Sledeci() override
+		{
+			if (++i == l->broj)
+			{
+				l = l->sledeci;
+				i = 0;
+			}
+		}
+		void Trazi(int k) override;
+	};
+
+	void* koren;	// nullptr za prazan skup
+	int visina;		// broj nivoa unutrasnjih cvorova - listovi su na nivou 0
+	int n;
+	List* prvi;
+	List* poslednji;
+	Bazen<List> listovi;
+	Bazen<Cvor> cvorovi;
+
+	void obrisi();
+	void premesti(BPlusSkup& s);
+	void izgradi(const int* niz, int broj); // od sortiranih kljuceva bez ponavljanja, u prazno stablo
+
+	// broj elemenata niza manjih od k (UKLJUCIV: ne vecih od k); u malim cvorovima linearno i bez grananja
+	template <bool UKLJUCIV>
+	static inline int prebroj(const int* niz, int broj, int k);
+
+	const List* list(int k) const; // list u koji k pripada
+	static inline void predUcitajCvor(const void* p, size_t velicina);
+
+	bool umetni(void* p, int nivo, int k, int& razdelnik, void*& novi);
+
+	/* posle brisanja opsega iz podstabla svi cvorovi ispod p imaju bar najmanju popunjenost, osim ako
+	p ostane sa jednim detetom - tada ga roditelj spaja sa susedom i popravlja i to dete */
+	int obrisiOpseg(void* p, int nivo, int min, int max);
+	int unisti(void* p, int nivo); // vraca broj kljuceva u unistenom podstablu
+	void izbaciList(List* l);
+	bool manjak(const void* p, int nivo) const;
+	bool spojiDecu(Cvor* c, int nivo, int i); // deca i i i + 1 se spajaju (true) ili ravnomerno dele kljuceve
+	void popravi(Cvor* c, int nivo, int od, int doo);
+	void skratiKoren();
+
+	template <class F>
+	void spajanje(const BPlusSkup& drugi, int delovi, F f) const;
+
+	void pisi(ostream& o) const override;
+
+	BPlusSkup* spojiSa(const Skup& s2, int delovi) const override;
+	bool postoji(const Skup& s2, int delovi) const override;
+	void preuzmi(Skup* s) override;
+	BPlusSkup* prazan() const override;
+
+	uintptr_t pozicijaNeManjegOd(int k) const override;
+	uintptr_t pozicijaKraja() const override;
+	uintptr_t sledecaPozicija(uintptr_t p) const override;
+	uintptr_t prethodnaPozicija(uintptr_t p) const override;
+	int kljucNaPoziciji(uintptr_t p) const override;
+
+public:
+	BPlusSkup() :koren(nullptr), visina(0), n(0), prvi(nullptr), poslednji(nullptr) {}
+	BPlusSkup(const BPlusSkup& s);
+	BPlusSkup(BPlusSkup&& s) :BPlusSkup() { premesti(s); }
+	~BPlusSkup() override {}
+
+	BPlusSkup& operator=(const BPlusSkup& s);
+	BPlusSkup& operator=(BPlusSkup&& s);
+
+	bool PostojanjeElementa(int k) const override;
+	void PostojanjeElemenata(const int* kljucevi, size_t broj, bool* rezultat) const override;
+	BPlusSkup& UmetniElement(int k) override;
+	BPlusSkup& UmetniElemente(const int* niz, int broj) override;
+
+	BPlusSkup& ObrisiElement(int k) override;
+	BPlusSkup& ObrisiOpsegVrednosti(int min, int max) override;
+
+	int BrojElemenata() const override { return n; }
+
+	void IsprazniSkup() override { INSTRUMENTISI(PRAZNJENJE); obrisi(); }
+
+	BPlusSkup* Razlika(const Skup& s2) const;
+	BPlusSkup& RazlikaUMestu(const Skup& s2) override;
+
+	unique_ptr<Skup::Kursor> NapraviKursor() const override;
+
+	// konkretan iterator kroz povezane listove (bez virtuelnih poziva) zaklanja Skup::Iterator
+	class Iterator
+	{
+		const List* l; // nullptr je kraj
+		int i;
+		const List* poslednji;
+
+	public:
+		typedef bidirectional_iterator_tag iterator_category;
+		typedef int value_type;
+		typedef ptrdiff_t difference_type;
+		typedef const int* pointer;
+		typedef const int& reference;
+
+		Iterator(const List* _l = nullptr, int _i = 0, const List* _poslednji = nullptr) :l(_l), i(_i), poslednji(_poslednji) {}
+
+		const int& operator*() const { return l->kljucevi[i]; }
+		const int* operator->() const { return &l->kljucevi[i]; }
+
+		Iterator& operator++()
+		{
+			if (++i == l->broj)
+			{
+				l = l->sledeci;
+				i = 0;
+			}
+			return *this;
+		}
+		Iterator& operator--()
+		{
+			if (l == nullptr)
+				l = poslednji, i = l->broj;
+			else if (i == 0)
+				l = l->prethodni, i = l->broj;
+			i--;
+			return *this;
+		}
+		Iterator operator++(int) { Iterator it = *this; ++*this; return it; }
+		Iterator operator--(int) { Iterator it = *this; --*this; return it; }
+
+		bool operator==(const Iterator& it) const { return l == it.l && i == it.i; }
+		bool operator!=(const Iterator& it) const { return !(*this == it); }
+	};
+
+	Iterator begin() const { return Iterator(prvi, 0, poslednji); }
+	Iterator end() const { return Iterator(nullptr, 0, poslednji); }
+	Iterator lower_bound(int k) const;
+	Iterator upper_bound(int k) const { return k == INT_MAX ? end() : lower_bound(k + 1); }
+
+	// listovi se broje celi, a pretrazuju samo granicni - O(log n + k / U_LISTU)
+	int BrojUOpsegu(int min, int max) const override;
+
+	StatistikaAlokacije StatistikaAlokatora() const override;
+};
+
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::Kursor::Trazi(int k)
+{
+	if (l == nullptr || l->kljucevi[i] >= k)
+		return;
+
+	// cilj u tekucem listu se trazi u njemu, a dalji spustanjem od korena
+	if (l->kljucevi[l->broj - 1] < k)
+	{
+		l = skup->list(k);
+		i = 0;
+	}
+
+	i += prebroj<false>(l->kljucevi + i, l->broj - i, k);
+	if (i == l->broj)
+	{
+		l = l->sledeci;
+		i = 0;
+	}
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE>::BPlusSkup(const BPlusSkup & s) :BPlusSkup()
+{
+	vector<int> kljucevi;
+	kljucevi.reserve(s.n);
+	for (const List* l = s.prvi; l != nullptr; l = l->sledeci)
+		kljucevi.insert(kljucevi.end(), l->kljucevi, l->kljucevi + l->broj);
+
+	izgradi(kljucevi.data(), (int)kljucevi.size());
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE> & BPlusSkup<GRANANJE>::operator=(const BPlusSkup & s)
+{
+	if (this != &s)
+	{
+		BPlusSkup kopija(s);
+		obrisi();
+		premesti(kopija);
+	}
+
+	return *this;
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE> & BPlusSkup<GRANANJE>::operator=(BPlusSkup && s)
+{
+	if (this != &s) { obrisi(); premesti(s); }
+
+	return *this;
+}
+
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::obrisi()
+{
+	listovi.OslobodiSve();
+	cvorovi.OslobodiSve();
+
+	koren = nullptr;
+	visina = 0;
+	n = 0;
+	prvi = poslednji = nullptr;
+}
+
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::premesti(BPlusSkup & s)
+{
+	swap(koren, s.koren);
+	swap(visina, s.visina);
+	swap(n, s.n);
+	swap(prvi, s.prvi);
+	swap(poslednji, s.poslednji);
+	listovi.Zameni(s.listovi);
+	cvorovi.Zameni(s.cvorovi);
+}
+
+// kljucevi se ravnomerno dele na najmanji broj listova, a deca na najmanji broj cvorova iznad njih
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::izgradi(const int * niz, int broj)
+{
+	if (broj == 0)
+		return;
+
+	int listova = (broj + U_LISTU - 1) / U_LISTU;
+	vector<void*> nivo(listova);
+	vector<int> najmanji(listova); // najmanji kljuc u podstablu, razdelnik u roditelju
+
+	List* prethodni = nullptr;
+	for (int j = 0, od = 0; j < listova; j++)
+	{
+		List* l = listovi.Napravi();
+		l->broj = broj / listova + (j < broj % listova);
+		memcpy(l->kljucevi, niz + od, l->broj * sizeof(int));
+		l->prethodni = prethodni;
+		l->sledeci = nullptr;
+		(prethodni != nullptr ? prethodni->sledeci : prvi) = l;
+
+		prethodni = l;
+		nivo[j] = l;
+		najmanji[j] = niz[od];
+		od += l->broj;
+	}
+	poslednji = prethodni;
+
+	for (visina = 0; nivo.size() > 1; visina++)
+	{
+		size_t dece = nivo.size(), cvorova = (dece + GRANANJE - 1) / GRANANJE;
+		vector<void*> gornji(cvorova);
+		vector<int> gornjiNajmanji(cvorova);
+
+		for (size_t j = 0, od = 0; j < cvorova; j++)
+		{
+			size_t m = dece / cvorova + (j < dece % cvorova);
+			Cvor* c = cvorovi.Napravi();
+			c->broj = (int)m - 1;
+			for (size_t t = 0; t < m; t++)
+			{
+				c->deca[t] = nivo[od + t];
+				if (t > 0)
+					c->kljucevi[t - 1] = najmanji[od + t];
+			}
+
+			gornji[j] = c;
+			gornjiNajmanji[j] = najmanji[od];
+			od += m;
+		}
+
+		nivo.swap(gornji);
+		najmanji.swap(gornjiNajmanji);
+	}
+
+	koren = nivo[0];
+	n = broj;
+}
+
+template <int GRANANJE>
+template <bool UKLJUCIV>
+inline int BPlusSkup<GRANANJE>::prebroj(const int * niz, int broj, int k)
+{
+	BROJI_POSETU(broj > 64 ? Instrumentacija::BrojKoraka(broj) : broj);
+	if (broj > 64)
+		return (int)((UKLJUCIV ? std::upper_bound(niz, niz + broj, k) : std::lower_bound(niz, niz + broj, k)) - niz);
+
+	int i = 0, j = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+	// poredjenje daje -1 za svaki kljuc koji se broji (UKLJUCIV: koji je veci od k, pa se oduzima)
+	__m128i kk = _mm_set1_epi32(k), zbir = _mm_setzero_si128();
+	for (; j + 4 <= broj; j += 4)
+	{
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(niz + j));
+		zbir = _mm_sub_epi32(zbir, UKLJUCIV ? _mm_cmpgt_epi32(v, kk) : _mm_cmpgt_epi32(kk, v));
+	}
+	zbir = _mm_add_epi32(zbir, _mm_shuffle_epi32(zbir, _MM_SHUFFLE(1, 0, 3, 2)));
+	zbir = _mm_add_epi32(zbir, _mm_shuffle_epi32(zbir, _MM_SHUFFLE(2, 3, 0, 1)));
+	i = UKLJUCIV ? j - _mm_cvtsi128_si32(zbir) : _mm_cvtsi128_si32(zbir);
+#endif
+
+	for (; j < broj; j++)
+		i += UKLJUCIV ? niz[j] <= k : niz[j] < k;
+
+	return i;
+}
+
+template <int GRANANJE>
+const typename BPlusSkup<GRANANJE>::List * BPlusSkup<GRANANJE>::list(int k) const
+{
+	const void* p = koren;
+	for (int nivo = visina; nivo > 0; nivo--)
+	{
+		const Cvor* c = static_cast<const Cvor*>(p);
+		p = c->deca[prebroj<true>(c->kljucevi, c->broj, k)];
+	}
+
+	return static_cast<const List*>(p);
+}
+
+template <int GRANANJE>
+inline void BPlusSkup<GRANANJE>::predUcitajCvor(const void * p, size_t velicina)
+{
+	for (size_t b = 0; b < velicina; b += 64)
+		predUcitaj(static_cast<const char*>(p) + b);
+}
+
+template <int GRANANJE>
+bool BPlusSkup<GRANANJE>::umetni(void * p, int nivo, int k, int & razdelnik, void *& novi)
+{
+	novi = nullptr;
+
+	if (nivo == 0)
+	{
+		List* l = static_cast<List*>(p);
+		int i = prebroj<false>(l->kljucevi, l->broj, k);
+		if (i < l->broj && l->kljucevi[i] == k)
+			return false;
+
+		// pun list predaje gornju polovinu novom listu odmah iza sebe
+		if (l->broj == U_LISTU)
+		{
+			List* d = listovi.Napravi();
+			int pola = (U_LISTU + 1) / 2;
+			d->broj = U_LISTU - pola;
+			memcpy(d->kljucevi, l->kljucevi + pola, d->broj * sizeof(int));
+			l->broj = pola;
+
+			d->prethodni = l;
+			d->sledeci = l->sledeci;
+			(l->sledeci != nullptr ? l->sledeci->prethodni : poslednji) = d;
+			l->sledeci = d;
+
+			novi = d;
+			if (i > pola)
+			{
+				l = d;
+				i -= pola;
+			}
+		}
+
+		memmove(l->kljucevi + i + 1, l->kljucevi + i, (l->broj - i) * sizeof(int));
+		l->kljucevi[i] = k;
+		l->broj++;
+
+		if (novi != nullptr)
+			razdelnik = static_cast<List*>(novi)->kljucevi[0];
+
+		return true;
+	}
+
+	Cvor* c = static_cast<Cvor*>(p);
+	int i = prebroj<true>(c->kljucevi, c->broj, k);
+
+	int r;
+	void* d;
+	if (!umetni(c->deca[i], nivo - 1, k, r, d))
+		return false;
+	if (d == nullptr)
+		return true;
+
+	if (c->broj < U_CVORU)
+	{
+		memmove(c->kljucevi + i + 1, c->kljucevi + i, (c->broj - i) * sizeof(int));
+		memmove(c->deca + i + 2, c->deca + i + 1, (c->broj - i) * sizeof(void*));
+		c->kljucevi[i] = r;
+		c->deca[i + 1] = d;
+		c->broj++;
+
+		return true;
+	}
+
+	// pun cvor se deli na dva, a srednji razdelnik prelazi u roditelja
+	int kljucevi[U_CVORU + 1];
+	void* deca[GRANANJE + 1];
+
+	memcpy(kljucevi, c->kljucevi, i * sizeof(int));
+	kljucevi[i] = r;
+	memcpy(kljucevi + i + 1, c->kljucevi + i, (U_CVORU - i) * sizeof(int));
+	memcpy(deca, c->deca, (i + 1) * sizeof(void*));
+	deca[i + 1] = d;
+	memcpy(deca + i + 2, c->deca + i + 1, (U_CVORU - i) * sizeof(void*));
+
+	Cvor* desni = cvorovi.Napravi();
+	int levo = (U_CVORU + 1) / 2;
+
+	c->broj = levo;
+	memcpy(c->kljucevi, kljucevi, levo * sizeof(int));
+	memcpy(c->deca, deca, (levo + 1) * sizeof(void*));
+
+	desni->broj = U_CVORU - levo;
+	memcpy(desni->kljucevi, kljucevi + levo + 1, desni->broj * sizeof(int));
+	memcpy(desni->deca, deca + levo + 1, (desni->broj + 1) * sizeof(void*));
+
+	razdelnik = kljucevi[levo];
+	novi = desni;
+
+	return true;
+}
+
+template <int GRANANJE>
+int BPlusSkup<GRANANJE>::obrisiOpseg(void * p, int nivo, int min, int max)
+{
+	if (nivo == 0)
+	{
+		List* l = static_cast<List*>(p);
+		int od = prebroj<false>(l->kljucevi, l->broj, min);
+		int doo = prebroj<true>(l->kljucevi, l->broj, max);
+		if (od >= doo)
+			return 0;
+
+		memmove(l->kljucevi + od, l->kljucevi + doo, (l->broj - doo) * sizeof(int));
+		l->broj -= doo - od;
+
+		return doo - od;
+	}
+
+	Cvor* c = static_cast<Cvor*>(p);
+	int prvo = prebroj<true>(c->kljucevi, c->broj, min);
+	int poslednje = prebroj<true>(c->kljucevi, c->broj, max);
+	int obrisano = 0;
+
+	// deca izmedju granicnih su cela u opsegu i oslobadjaju se bez pretrage
+	if (poslednje > prvo + 1)
+	{
+		for (int j = prvo + 1; j < poslednje; j++)
+			obrisano += unisti(c->deca[j], nivo - 1);
+
+		memmove(c->kljucevi + prvo, c->kljucevi + poslednje - 1, (c->broj - poslednje + 1) * sizeof(int));
+		memmove(c->deca + prvo + 1, c->deca + poslednje, (c->broj - poslednje + 1) * sizeof(void*));
+		c->broj -= poslednje - prvo - 1;
+		poslednje = prvo + 1;
+	}
+
+	obrisano += obrisiOpseg(c->deca[prvo], nivo - 1, min, max);
+	if (poslednje != prvo)
+		obrisano += obrisiOpseg(c->deca[poslednje], nivo - 1, min, max);
+
+	popravi(c, nivo, prvo, poslednje);
+
+	return obrisano;
+}
+
+template <int GRANANJE>
+int BPlusSkup<GRANANJE>::unisti(void * p, int nivo)
+{
+	if (nivo == 0)
+	{
+		List* l = static_cast<List*>(p);
+		int broj = l->broj;
+		izbaciList(l);
+
+		return broj;
+	}
+
+	Cvor* c = static_cast<Cvor*>(p);
+	int broj = 0;
+	for (int j = 0; j <= c->broj; j++)
+		broj += unisti(c->deca[j], nivo - 1);
+	cvorovi.Unisti(c);
+
+	return broj;
+}
+
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::izbaciList(List * l)
+{
+	(l->prethodni != nullptr ? l->prethodni->sledeci : prvi) = l->sledeci;
+	(l->sledeci != nullptr ? l->sledeci->prethodni : poslednji) = l->prethodni;
+
+	listovi.Unisti(l);
+}
+
+template <int GRANANJE>
+bool BPlusSkup<GRANANJE>::manjak(const void * p, int nivo) const
+{
+	if (nivo == 0)
+		return static_cast<const List*>(p)->broj < MIN_U_LISTU;
+
+	return static_cast<const Cvor*>(p)->broj < MIN_U_CVORU;
+}
+
+template <int GRANANJE>
+bool BPlusSkup<GRANANJE>::spojiDecu(Cvor * c, int nivo, int i)
+{
+	bool spojeni;
+
+	if (nivo == 1)
+	{
+		List* a = static_cast<List*>(c->deca[i]);
+		List* b = static_cast<List*>(c->deca[i + 1]);
+		int ukupno = a->broj + b->broj;
+
+		spojeni = ukupno <= U_LISTU;
+		if (spojeni)
+		{
+			memcpy(a->kljucevi + a->broj, b->kljucevi, b->broj * sizeof(int));
+			a->broj = ukupno;
+			izbaciList(b);
+		}
+		else
+		{
+			int levo = ukupno / 2;
+			if (a->broj > levo)
+			{
+				int m = a->broj - levo;
+				memmove(b->kljucevi + m, b->kljucevi, b->broj * sizeof(int));
+				memcpy(b->kljucevi, a->kljucevi + levo, m * sizeof(int));
+			}
+			else
+			{
+				int m = levo - a->broj;
+				memcpy(a->kljucevi + a->broj, b->kljucevi, m * sizeof(int));
+				memmove(b->kljucevi, b->kljucevi + m, (b->broj - m) * sizeof(int));
+			}
+
+			a->broj = levo;
+			b->broj = ukupno - levo;
+			c->kljucevi[i] = b->kljucevi[0];
+		}
+	}
+	else
+	{
+		Cvor* a = static_cast<Cvor*>(c->deca[i]);
+		Cvor* b = static_cast<Cvor*>(c->deca[i + 1]);
+		int ukupno = a->broj + b->broj + 1; // sa razdelnikom iz c
+
+		spojeni = ukupno <= U_CVORU;
+		if (spojeni)
+		{
+			a->kljucevi[a->broj] = c->kljucevi[i];
+			memcpy(a->kljucevi + a->broj + 1, b->kljucevi, b->broj * sizeof(int));
+			memcpy(a->deca + a->broj + 1, b->deca, (b->broj + 1) * sizeof(void*));
+			a->broj = ukupno;
+			cvorovi.Unisti(b);
+		}
+		else
+		{
+			int kljucevi[2 * U_CVORU + 1];
+			void* deca[2 * GRANANJE];
+
+			memcpy(kljucevi, a->kljucevi, a->broj * sizeof(int));
+			kljucevi[a->broj] = c->kljucevi[i];
+			memcpy(kljucevi + a->broj + 1, b->kljucevi, b->broj * sizeof(int));
+			memcpy(deca, a->deca, (a->broj + 1) * sizeof(void*));
+			memcpy(deca + a->broj + 1, b->deca, (b->broj + 1) * sizeof(void*));
+
+			int levo = (ukupno - 1) / 2;
+			a->broj = levo;
+			memcpy(a->kljucevi, kljucevi, levo * sizeof(int));
+			memcpy(a->deca, deca, (levo + 1) * sizeof(void*));
+
+			c->kljucevi[i] = kljucevi[levo];
+
+			b->broj = ukupno - 1 - levo;
+			memcpy(b->kljucevi, kljucevi + levo + 1, b->broj * sizeof(int));
+			memcpy(b->deca, deca + levo + 1, (b->broj + 1) * sizeof(void*));
+		}
+	}
+
+	if (spojeni)
+	{
+		memmove(c->kljucevi + i, c->kljucevi + i + 1, (c->broj - i - 1) * sizeof(int));
+		memmove(c->deca + i + 1, c->deca + i + 2, (c->broj - i - 1) * sizeof(void*));
+		c->broj--;
+	}
+
+	return spojeni;
+}
+
+/* deca c sa indeksima iz [od, doo] koja su ispod najmanje popunjenosti spajaju se sa susedom ili
+dele kljuceve sa njim. Ako je jedno od njih bilo cvor sa jednim detetom, to dete je moglo ostati u
+manjku, pa se popravljaju i deca dobijenih cvorova */
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::popravi(Cvor * c, int nivo, int od, int doo)
+{
+	for (int i = od; i <= doo && i <= c->broj && c->broj > 0; )
+	{
+		if (!manjak(c->deca[i], nivo - 1))
+		{
+			i++;
+			continue;
+		}
+
+		int l = i < c->broj ? i : i - 1;
+		bool sJednimDetetom = nivo > 1 && (static_cast<Cvor*>(c->deca[l])->broj == 0 || static_cast<Cvor*>(c->deca[l + 1])->broj == 0);
+
+		bool spojeni = spojiDecu(c, nivo, l);
+		if (sJednimDetetom)
+		{
+			popravi(static_cast<Cvor*>(c->deca[l]), nivo - 1, 0, GRANANJE);
+			if (!spojeni)
+				popravi(static_cast<Cvor*>(c->deca[l + 1]), nivo - 1, 0, GRANANJE);
+		}
+
+		if (spojeni && doo > l)
+			doo--;
+		i = l;
+	}
+}
+
+// koren bez razdelnika se zamenjuje jedinim detetom, a prazan list se uklanja
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::skratiKoren()
+{
+	while (visina > 0 && static_cast<Cvor*>(koren)->broj == 0)
+	{
+		Cvor* c = static_cast<Cvor*>(koren);
+		koren = c->deca[0];
+		cvorovi.Unisti(c);
+		visina--;
+	}
+
+	if (koren != nullptr && visina == 0 && static_cast<List*>(koren)->broj == 0)
+	{
+		izbaciList(static_cast<List*>(koren));
+		koren = nullptr;
+	}
+}
+
+// zajednicki obilazak dva stabla po listovima; f vraca false kada spajanje treba prekinuti
+template <int GRANANJE>
+template <class F>
+void BPlusSkup<GRANANJE>::spajanje(const BPlusSkup & drugi, int delovi, F f) const
+{
+	Kursor a(this), b(&drugi);
+	spajanjeKursora(a, b, delovi, f);
+}
+
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::pisi(ostream & o) const
+{
+	for (const List* l = prvi; l != nullptr; l = l->sledeci)
+		for (int i = 0; i < l->broj; i++)
+			o << l->kljucevi[i] << ' ';
+}
+
+template <int GRANANJE>
+bool BPlusSkup<GRANANJE>::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	if (koren == nullptr)
+		return false;
+
+	const List* l = list(k);
+	int i = prebroj<false>(l->kljucevi, l->broj, k);
+
+	return i < l->broj && l->kljucevi[i] == k;
+}
+
+// grupa kljuceva silazi nivo po nivo, a sledeci cvor svakog kljuca se ucitava unapred
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	const size_t GRUPA = 16;
+	const void* p[GRUPA];
+
+	if (koren == nullptr)
+	{
+		fill(rezultat, rezultat + broj, false);
+		return;
+	}
+
+	for (size_t od = 0; od < broj; od += GRUPA)
+	{
+		size_t m = min(GRUPA, broj - od);
+		for (size_t i = 0; i < m; i++)
+			p[i] = koren;
+
+		for (int nivo = visina; nivo > 0; nivo--)
+			for (size_t i = 0; i < m; i++)
+			{
+				const Cvor* c = static_cast<const Cvor*>(p[i]);
+				p[i] = c->deca[prebroj<true>(c->kljucevi, c->broj, kljucevi[od + i])];
+				predUcitajCvor(p[i], nivo > 1 ? sizeof(int) * (U_CVORU + 1) : sizeof(int) * (U_LISTU + 1));
+			}
+
+		for (size_t i = 0; i < m; i++)
+		{
+			const List* l = static_cast<const List*>(p[i]);
+			int j = prebroj<false>(l->kljucevi, l->broj, kljucevi[od + i]);
+			rezultat[od + i] = j < l->broj && l->kljucevi[j] == kljucevi[od + i];
+		}
+	}
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE> & BPlusSkup<GRANANJE>::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	if (koren == nullptr)
+	{
+		List* l = listovi.Napravi();
+		l->kljucevi[0] = k;
+		l->broj = 1;
+		l->prethodni = l->sledeci = nullptr;
+
+		koren = prvi = poslednji = l;
+		visina = 0;
+		n = 1;
+
+		return *this;
+	}
+
+	int razdelnik;
+	void* novi;
+	if (!umetni(koren, visina, k, razdelnik, novi))
+		return *this;
+
+	n++;
+
+	// podeljen koren - stablo raste za jedan nivo
+	if (novi != nullptr)
+	{
+		Cvor* c = cvorovi.Napravi();
+		c->broj = 1;
+		c->kljucevi[0] = razdelnik;
+		c->deca[0] = koren;
+		c->deca[1] = novi;
+
+		koren = c;
+		visina++;
+	}
+
+	return *this;
+}
+
+// kao kod AVLSkup: mala serija element po element, a velika spajanjem i izgradnjom u O(n + k)
+template <int GRANANJE>
+BPlusSkup<GRANANJE> & BPlusSkup<GRANANJE>::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	if (broj <= 0)
+		return *this;
+
+	if (broj < n / 16)
+	{
+		for (int i = 0; i < broj; i++)
+			UmetniElement(niz[i]);
+
+		return *this;
+	}
+
+	vector<int> kljucevi(niz, niz + broj);
+	pripremiSeriju(kljucevi);
+
+	if (n > 0)
+	{
+		vector<int> postojeci, spojeni;
+		postojeci.reserve(n);
+		for (const List* l = prvi; l != nullptr; l = l->sledeci)
+			postojeci.insert(postojeci.end(), l->kljucevi, l->kljucevi + l->broj);
+
+		spojeni.reserve(postojeci.size() + kljucevi.size());
+		set_union(postojeci.begin(), postojeci.end(), kljucevi.begin(), kljucevi.end(), back_inserter(spojeni));
+		kljucevi.swap(spojeni);
+	}
+
+	obrisi();
+	izgradi(kljucevi.data(), (int)kljucevi.size());
+
+	return *this;
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE> & BPlusSkup<GRANANJE>::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	if (koren == nullptr)
+		return *this;
+
+	n -= obrisiOpseg(koren, visina, k, k);
+	skratiKoren();
+
+	return *this;
+}
+
+/* podstabla cela u opsegu se oslobadjaju bez citanja kljuceva, a pretrazuju i popravljaju se samo
+dve putanje do granica opsega - O(log n + k / U_LISTU) */
+template <int GRANANJE>
+BPlusSkup<GRANANJE> & BPlusSkup<GRANANJE>::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	if (koren == nullptr)
+		return *this;
+
+	if (min <= prvi->kljucevi[0] && max >= poslednji->kljucevi[poslednji->broj - 1])
+	{
+		obrisi();
+		return *this;
+	}
+
+	n -= obrisiOpseg(koren, visina, min, max);
+	skratiKoren();
+
+	return *this;
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE> * BPlusSkup<GRANANJE>::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+// kljuc po kljuc u O(m log n), ili obilaskom oba niza listova i izgradnjom u O(n + m)
+template <int GRANANJE>
+BPlusSkup<GRANANJE> & BPlusSkup<GRANANJE>::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	const BPlusSkup* drugi = dynamic_cast<const BPlusSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+	{
+		razlikaUMestuKursorima(s2);
+		return *this;
+	}
+
+	if (drugi == this)
+	{
+		obrisi();
+		return *this;
+	}
+
+	if (n == 0 || drugi->n == 0)
+		return *this;
+
+	if (pojedinacno(drugi->n, n))
+	{
+		for (Kursor kursor(drugi); kursor.Vazeci(); kursor.Sledeci())
+			ObrisiElement(kursor.Kljuc());
+
+		return *this;
+	}
+
+	vector<int> kljucevi;
+	spajanje(*drugi, SAMO_PRVI, [&kljucevi](int k) { kljucevi.push_back(k); return true; });
+
+	obrisi();
+	izgradi(kljucevi.data(), (int)kljucevi.size());
+
+	return *this;
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE> * BPlusSkup<GRANANJE>::spojiSa(const Skup & s2, int delovi) const
+{
+	const BPlusSkup* drugi = dynamic_cast<const BPlusSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<BPlusSkup*>(spojiKursorima(s2, delovi));
+
+	vector<int> kljucevi;
+	spajanje(*drugi, delovi, [&kljucevi](int k) { kljucevi.push_back(k); return true; });
+
+	BPlusSkup* rezultat = new BPlusSkup();
+	rezultat->izgradi(kljucevi.data(), (int)kljucevi.size());
+
+	return rezultat;
+}
+
+template <int GRANANJE>
+bool BPlusSkup<GRANANJE>::postoji(const Skup & s2, int delovi) const
+{
+	const BPlusSkup* drugi = dynamic_cast<const BPlusSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return postojiKursorima(s2, delovi);
+
+	bool nadjen = false;
+	spajanje(*drugi, delovi, [&nadjen](int) { nadjen = true; return false; });
+
+	return nadjen;
+}
+
+template <int GRANANJE>
+void BPlusSkup<GRANANJE>::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<BPlusSkup*>(s));
+	delete s;
+}
+
+template <int GRANANJE>
+BPlusSkup<GRANANJE> * BPlusSkup<GRANANJE>::prazan() const
+{
+	return new BPlusSkup();
+}
+
+template <int GRANANJE>
+unique_ptr<Skup::Kursor> BPlusSkup<GRANANJE>::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new Kursor(this));
+}
+
+template <int GRANANJE>
+typename BPlusSkup<GRANANJE>::Iterator BPlusSkup<GRANANJE>::lower_bound(int k) const
+{
+	if (koren == nullptr)
+		return end();
+
+	const List* l = list(k);
+	int i = prebroj<false>(l->kljucevi, l->broj, k);
+	if (i == l->broj)
+	{
+		l = l->sledeci;
+		i = 0;
+	}
+
+	return Iterator(l, i, poslednji);
+}
+
+/* pozicija je kljuc + 1 (kao neoznacen broj), a kraj 0: kljuc u listu nema stalnu adresu jer ga
+umetanja i brisanja pomeraju, pa je korak spustanje od korena - brz obilazak daje Iterator */
+template <int GRANANJE>
+uintptr_t BPlusSkup<GRANANJE>::pozicijaNeManjegOd(int k) const
+{
+	Iterator it = lower_bound(k);
+
+	return it == end() ? 0 : (uintptr_t)((uint64_t)(uint32_t)*it + 1);
+}
+
+template <int GRANANJE>
+uintptr_t BPlusSkup<GRANANJE>::pozicijaKraja() const
+{
+	return 0;
+}
+
+template <int GRANANJE>
+uintptr_t BPlusSkup<GRANANJE>::sledecaPozicija(uintptr_t p) const
+{
+	int k = kljucNaPoziciji(p);
+
+	return k == INT_MAX ? 0 : pozicijaNeManjegOd(k + 1);
+}
+
+template <int GRANANJE>
+uintptr_t BPlusSkup<GRANANJE>::prethodnaPozicija(uintptr_t p) const
+{
+	Iterator it = p == 0 ? end() : lower_bound(kljucNaPoziciji(p));
+
+	return (uintptr_t)((uint64_t)(uint32_t)*--it + 1);
+}
+
+template <int GRANANJE>
+int BPlusSkup<GRANANJE>::kljucNaPoziciji(uintptr_t p) const
+{
+	return (int)(uint32_t)(p - 1);
+}
+
+template <int GRANANJE>
+int BPlusSkup<GRANANJE>::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (min > max)
+		throw INDEKS;
+
+	if (koren == nullptr)
+		return 0;
+
+	const List* l = list(min);
+	int broj = -prebroj<false>(l->kljucevi, l->broj, min);
+
+	for (; l != nullptr; l = l->sledeci)
+	{
+		if (l->kljucevi[l->broj - 1] > max)
+			return broj + prebroj<true>(l->kljucevi, l->broj, max);
+
+		broj += l->broj;
+	}
+
+	return broj;
+}
+
+template <int GRANANJE>
+StatistikaAlokacije BPlusSkup<GRANANJE>::StatistikaAlokatora() const
+{
+	StatistikaAlokacije s = listovi.Statistika();
+	s += cvorovi.Statistika();
+
+	return s;
+}
+
+#pragma endregion
+
+#pragma region "FabrikaSkupova.h"
+
+class FabrikaSkupova
+{
+
+public:
+	enum Vrsta { DCLL = 1, BST, AVL, NIZ, BITMAPA, DCLL_INDEKS, BST_RANG, KONKURENTNI, PARTICIONISANI, HASH, BPLUS };
+
+	static Skup* Napravi(int vrsta);
+	static const char* Opis(int vrsta);
+	static const char* Naziv(int vrsta); // kratak naziv za izvestaje i komandnu liniju
+	static int PoNazivu(const string& naziv); // 0 ako vrsta ne postoji
+	static int BrojVrsta() { return BPLUS; }
+	static bool Konkurentna(int vrsta) { return vrsta == KONKURENTNI || vrsta == PARTICIONISANI; } // moze se deliti izmedju niti
+
+};
+
+#pragma endregion
+
+#pragma region "IzvrsilacOpterecenja.h"
+
+/* neinteraktivni rad: ucitava datoteku sa operacijama (po jedna u redu), izvrsava ih nad
+izabranom vrstom skupa i izvestava o propusnosti i kasnjenju za svaku vrstu operacije */
+class IzvrsilacOpterecenja
+{
+
+public:
+	enum Tip { UMETANJE, BRISANJE, BRISANJE_OPSEGA, PRETRAGA, RAZLIKA, PRAZNJENJE, BROJ_TIPOVA };
+	enum Format { TEKST, CSV, JSON };
+
+	struct Operacija
+	{
+		Tip tip;
+		int a, b;
+		vector<int> kljucevi; // samo za razliku - elementi drugog skupa
+
+		Operacija(Tip _tip, int _a = 0, int _b = 0) :tip(_tip), a(_a), b(_b) {}
+	};
+
+	static const char* Naziv(Tip tip);
+
+	static bool Ucitaj(istream& ulaz, vector<Operacija>& operacije, string& greska);
+	/* merenja != nullptr: na kraju se ispisuju i brojaci instrumentacije skupa (uz -DINSTRUMENTACIJA);
+	uz snimak svako ponavljanje krece od njegovog sadrzaja umesto od praznog skupa, a za vrstu 0 se
+	snimak otvara samo za citanje (MapiraniSkup) i opterecenje sme da ima samo pretrage i razlike.
+	FORMAT ako snimak nije ispravan */
+	static void Izvrsi(int vrsta, const vector<Operacija>& operacije, int ponavljanja, ostream& izvestaj, Format format, ostream* merenja = nullptr, const string& snimak = "");
+
+	static int KomandnaLinija(int argc, char* argv[]);
+
+private:
+	static void uputstvo(ostream& o);
+
+};
+
+#pragma endregion
+
+#pragma region "UvozKljuceva.h"
+
+/* brzo ucitavanje celih brojeva iz tekstualne datoteke: datoteka se cita u velikim blokovima,
+a brojevi se parsiraju sa from_chars bez pravljenja niski; razdvojeni su belinama (po jedan u redu) */
+class UvozKljuceva
+{
+
+private:
+	static const size_t VELICINA_BLOKA = 1 << 20;
+	static const size_t MAKS_BROJ = 64; // najduzi zapis broja koji moze biti presecen granicom bloka
+
+	static inline bool belina(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+public:
+	// na gresku vraca false i opis sa brojem reda; kljucevi su u redosledu iz datoteke
+	static bool Ucitaj(const string& datoteka, vector<int>& kljucevi, string& greska);
+
+};
+
+#pragma endregion
+
+#pragma region "Instrumentacija.cpp"
+
+Instrumentacija::Izvestaj::Izvestaj() :ukljuceno(false), poziva(), ukupnoNs(), kasnjenja(), poredjenja(0), posecenihCvorova(0), alokacija(0), najvecaDubina(0)
+{
+}
+
+uint64_t Instrumentacija::Izvestaj::Kvantil(Operacija op, double p) const
+{
+	uint64_t zbir = 0;
+	for (int i = 0; i < KORPI; i++)
+	{
+		zbir += kasnjenja[op][i];
+		if (zbir > 0 && zbir >= p * poziva[op])
+			return (uint64_t)1 << (i + 1);
+	}
+
+	return 0;
+}
+
+void Instrumentacija::Izvestaj::Ispisi(ostream & o, Format format) const
+{
+	if (format == JSON)
+	{
+		o << "{\"ukljuceno\": " << (ukljuceno ? "true" : "false") << ", \"poredjenja\": " << poredjenja << ", \"poseceni_cvorovi\": " << posecenihCvorova
+			<< ", \"alokacije\": " << alokacija << ", \"najveca_dubina\": " << najvecaDubina << ", \"operacije\": {";
+
+		bool prva = true;
+		for (int op = 0; op < BROJ_OPERACIJA; op++)
+		{
+			if (poziva[op] == 0)
+				continue;
+
+			o << (prva ? "" : ",") << endl << "  \"" << Naziv((Operacija)op) << "\": {\"poziva\": " << poziva[op] << ", \"ukupno_ns\": " << ukupnoNs[op]
+				<< ", \"p50_ns\": " << Kvantil((Operacija)op, 0.5) << ", \"p99_ns\": " << Kvantil((Operacija)op, 0.99) << ", \"histogram_ns\": [";
+
+			// parovi [donja granica korpe, broj poziva] za neprazne korpe
+			bool prvaKorpa = true;
+			for (int i = 0; i < KORPI; i++)
+				if (kasnjenja[op][i] != 0)
+				{
+					o << (prvaKorpa ? "" : ", ") << '[' << ((uint64_t)1 << i) << ", " << kasnjenja[op][i] << ']';
+					prvaKorpa = false;
+				}
+
+			o << "]}";
+			prva = false;
+		}
+
+		o << endl << "}}" << endl;
+		return;
+	}
+
+	if (!ukljuceno)
+	{
+		o << "Merenja nisu ukljucena (program nije preveden sa -DINSTRUMENTACIJA)" << endl;
+		return;
+	}
+
+	o << "Poredjenja kljuceva: " << poredjenja << ", posecenih cvorova: " << posecenihCvorova << ", alokacija: " << alokacija
+		<< ", najveca dubina: " << najvecaDubina << endl;
+
+	for (int op = 0; op < BROJ_OPERACIJA; op++)
+	{
+		if (poziva[op] == 0)
+			continue;
+
+		o << "  " << Naziv((Operacija)op) << ": " << poziva[op] << " poziva, prosek " << ukupnoNs[op] / poziva[op] << " ns, p50 < "
+			<< Kvantil((Operacija)op, 0.5) << " ns, p99 < " << Kvantil((Operacija)op, 0.99) << " ns" << endl << "   ";
+
+		for (int i = 0; i < KORPI; i++)
+			if (kasnjenja[op][i] != 0)
+				o << ' ' << ((uint64_t)1 << i) << "+ ns: " << kasnjenja[op][i];
+		o << endl;
+	}
+}
+
+const char * Instrumentacija::Naziv(Operacija op)
+{
+	switch (op)
+	{
+	case POSTOJANJE: return "postojanje";
+	case POSTOJANJE_SERIJE: return "postojanje_serije";
+	case UMETANJE: return "umetanje";
+	case UMETANJE_SERIJE: return "umetanje_serije";
+	case BRISANJE: return "brisanje";
+	case BRISANJE_SERIJE: return "brisanje_serije";
+	case BRISANJE_OPSEGA: return "brisanje_opsega";
+	case PRAZNJENJE: return "praznjenje";
+	case RAZLIKA: return "razlika";
+	case RAZLIKA_U_MESTU: return "razlika_u_mestu";
+	case PRESEK: return "presek";
+	case UNIJA: return "unija";
+	case SIMETRICNA_RAZLIKA: return "simetricna_razlika";
+	case PODSKUP: return "podskup";
+	case IMA_PRESEK: return "ima_presek";
+	case BROJ_U_OPSEGU: return "broj_u_opsegu";
+	case CUVANJE: return "cuvanje";
+	case UCITAVANJE: return "ucitavanje";
+	default: return "";
+	}
+}
+
+int Instrumentacija::BrojKoraka(size_t n)
+{
+	int koraka = 0;
+	for (; n > 0; n >>= 1)
+		koraka++;
+
+	return koraka;
+}
+
+#ifdef INSTRUMENTACIJA
+
+thread_local Instrumentacija::Lokalno Instrumentacija::lokalno;
+
+Instrumentacija::Izvestaj Instrumentacija::Stanje() const
+{
+	Izvestaj izvestaj;
+	izvestaj.ukljuceno = true;
+
+	for (int op = 0; op < BROJ_OPERACIJA; op++)
+	{
+		izvestaj.poziva[op] = poziva[op].load(memory_order_relaxed);
+		izvestaj.ukupnoNs[op] = ukupnoNs[op].load(memory_order_relaxed);
+		for (int i = 0; i < KORPI; i++)
+			izvestaj.kasnjenja[op][i] = kasnjenja[op][i].load(memory_order_relaxed);
+	}
+
+	izvestaj.poredjenja = poredjenja.load(memory_order_relaxed);
+	izvestaj.posecenihCvorova = posecenihCvorova.load(memory_order_relaxed);
+	izvestaj.alokacija = alokacija.load(memory_order_relaxed);
+	izvestaj.najvecaDubina = najvecaDubina.load(memory_order_relaxed);
+
+	return izvestaj;
+}
+
+void Instrumentacija::Ponisti()
+{
+	for (int op = 0; op < BROJ_OPERACIJA; op++)
+	{
+		poziva[op].store(0, memory_order_relaxed);
+		ukupnoNs[op].store(0, memory_order_relaxed);
+		for (int i = 0; i < KORPI; i++)
+			kasnjenja[op][i].store(0, memory_order_relaxed);
+	}
+
+	poredjenja.store(0, memory_order_relaxed);
+	posecenihCvorova.store(0, memory_order_relaxed);
+	alokacija.store(0, memory_order_relaxed);
+	najvecaDubina.store(0, memory_order_relaxed);
+}
+
+Instrumentacija::Merac::Merac(Instrumentacija & i, Operacija op) :instrumentacija(nullptr), operacija(op)
+{
+	if (lokalno.aktivno)
+		return;
+
+	lokalno = { 0, 0, 0, true };
+	instrumentacija = &i;
+	pocetak = chrono::steady_clock::now();
+}
+
+Instrumentacija::Merac::~Merac()
+{
+	if (instrumentacija == nullptr)
+		return;
+
+	uint64_t ns = (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - pocetak).count();
+	int korpa = min(BrojKoraka(ns) - 1, KORPI - 1);
+	Instrumentacija& i = *instrumentacija;
+
+	i.poziva[operacija].fetch_add(1, memory_order_relaxed);
+	i.ukupnoNs[operacija].fetch_add(ns, memory_order_relaxed);
+	i.kasnjenja[operacija][korpa < 0 ? 0 : korpa].fetch_add(1, memory_order_relaxed);
+	i.poredjenja.fetch_add(lokalno.poredjenja, memory_order_relaxed);
+	i.posecenihCvorova.fetch_add(lokalno.posecenih, memory_order_relaxed);
+	i.alokacija.fetch_add(lokalno.alokacija, memory_order_relaxed);
+
+	// dubina se meri samo na operacijama nad jednim kljucem, gde je broj posecenih cvorova duzina putanje
+	if (operacija == POSTOJANJE || operacija == UMETANJE || operacija == BRISANJE)
+	{
+		uint64_t dubina = i.najvecaDubina.load(memory_order_relaxed);
+		while (lokalno.posecenih > dubina && !i.najvecaDubina.compare_exchange_weak(dubina, lokalno.posecenih, memory_order_relaxed));
+	}
+
+	lokalno.aktivno = false;
+}
+
+#endif
+
+#pragma endregion
+
+#pragma region "AnalizatorPerformansi.cpp"
+
+AnalizatorPerformansi::Konfiguracija AnalizatorPerformansi::konfiguracija;
+
+// RAND_MAX je 0x7FFF na Windows-u, a 2^31 - 1 na Linux-u; uzimanjem po 15 bitova dobija se isti
+// 30-bitni opseg kljuceva na obe platforme i izbegava prekoracenje u rand() * (RAND_MAX + 1)
+int AnalizatorPerformansi::slucajanKljuc()
+{
+	return ((rand() & 0x7FFF) << 15) | (rand() & 0x7FFF);
+}
+
+double AnalizatorPerformansi::FormirajSkup(Skup & skup, int velicina, int seme)
+{
+	PerformanceCalculator pc;
+	double t = 0; // vreme
+
+	// merenje formiranja (zagrevanje + ponavljanja) puta, u prosek ulaze samo ponavljanja
+	for (int i = 1; i <= konfiguracija.zagrevanje + konfiguracija.ponavljanja; i++)
+	{
+		if (i != 1)
+			skup.IsprazniSkup();
+
+		pc.start();
+
+		srand(seme);
+		// dodavanje 'velicina' elemenata
+		for (int k = 1; k <= velicina; k++)
+			skup.UmetniElement(slucajanKljuc());
+
+		pc.stop();
+		if (i > konfiguracija.zagrevanje)
+			t += pc.elapsedMillis();
+	}
+
+	return t / konfiguracija.ponavljanja;
+}
+
+double AnalizatorPerformansi::Umetanje(Skup & skup, int novi)
+{
+	PerformanceCalculator pc;
+
+	pc.start();
+	skup.UmetniElement(novi);
+	pc.stop();
+
+	return pc.elapsedMillis();
+}
+
+double AnalizatorPerformansi::Brisanje(Skup & skup, int k)
+{
+	PerformanceCalculator pc;
+
+	pc.start();
+	skup.ObrisiElement(k);
+	pc.stop();
+
+	return pc.elapsedMillis();
+}
+
+double AnalizatorPerformansi::Pretraga(Skup & skup, int k, bool & postoji)
+{
+	PerformanceCalculator pc;
+	double t = 0;
+
+	for (int i = 1; i <= konfiguracija.zagrevanje + konfiguracija.ponavljanja; i++)
+	{
+		pc.start();
+		postoji = skup.PostojanjeElementa(k);
+		pc.stop();
+
+		if (i > konfiguracija.zagrevanje)
+			t += pc.elapsedMillis();
+	}
+
+	return t / konfiguracija.ponavljanja;
+}
+
+double AnalizatorPerformansi::BrisanjeOpsegaVrednosti(Skup & skup, int min, int max)
+{
+	PerformanceCalculator pc;
+
+	pc.start();
+	skup.ObrisiOpsegVrednosti(min, max);
+	pc.stop();
+
+	return pc.elapsedMillis();
+}
+
+double AnalizatorPerformansi::Razlika(Skup & s1, Skup & s2, int velicina)
+{
+	PerformanceCalculator pc;
+
+	// formiranje elemenata drugog skupa
+	for (int i = 1; i <= velicina; i++)
+		s2.UmetniElement(slucajanKljuc());
+
+	double t = 0;
+
+	for (int i = 1; i <= konfiguracija.zagrevanje + konfiguracija.ponavljanja; i++)
+	{
+		pc.start();
+		Skup* rez = s1 - s2;
+		pc.stop();
+
+		if (i > konfiguracija.zagrevanje)
+			t += pc.elapsedMillis();
+		delete rez;
+	}
+
+	return t / konfiguracija.ponavljanja;
+}
+
+StatistikaMerenja AnalizatorPerformansi::Statistika(vector<double> uzorci, vector<long long> ciklusi)
+{
+	StatistikaMerenja s;
+	s.uzoraka = (int)uzorci.size();
+	if (uzorci.empty())
+		return s;
+
+	sort(uzorci.begin(), uzorci.end());
+
+	size_t n = uzorci.size();
+	s.min = uzorci.front();
+	s.medijana = n % 2 == 1 ? uzorci[n / 2] : (uzorci[n / 2 - 1] + uzorci[n / 2]) / 2;
+	s.p99 = uzorci[(size_t)ceil(0.99 * n) - 1]; // najblizi rang
+
+	double suma = 0;
+	for (double u : uzorci)
+		suma += u;
+	s.prosek = suma / n;
+
+	double kvadrati = 0;
+	for (double u : uzorci)
+		kvadrati += (u - s.prosek) * (u - s.prosek);
+	s.stdDev = n > 1 ? sqrt(kvadrati / (n - 1)) : 0;
+
+	if (!ciklusi.empty() && ciklusi.front() >= 0)
+	{
+		sort(ciklusi.begin(), ciklusi.end());
+		s.ciklusiMedijana = (double)ciklusi[ciklusi.size() / 2];
+	}
+
+	return s;
+}
+
+// priprema i vracanje stanja se izvrsavaju oko svakog merenja, ali ne ulaze u vreme
+StatistikaMerenja AnalizatorPerformansi::meri(const function<void()>& priprema, const function<void()>& operacija, const function<void()>& vracanje)
+{
+	PerformanceCalculator pc(konfiguracija.brojac);
+	vector<double> uzorci;
+	vector<long long> ciklusi;
+
+	for (int i = 1; i <= konfiguracija.zagrevanje + konfiguracija.ponavljanja; i++)
+	{
+		if (priprema)
+			priprema();
+
+		pc.start();
+		operacija();
+		pc.stop();
+
+		if (vracanje)
+			vracanje();
+
+		if (i > konfiguracija.zagrevanje)
+		{
+			uzorci.push_back(pc.elapsedMillis());
+			ciklusi.push_back(pc.elapsedCycles());
+		}
+	}
+
+	return Statistika(uzorci, ciklusi);
+}
+
+void AnalizatorPerformansi::PokreniSve(ostream & o, Format format, int velicina, int seme, const vector<int>& vrste)
+{
+	vector<int> izabrane = vrste;
+	if (izabrane.empty())
+		for (int v = 1; v <= FabrikaSkupova::BrojVrsta(); v++)
+			izabrane.push_back(v);
+
+	// kljucevi skupa su parni, a kljucevi za umetanje neparni, pa se ne preklapaju
+	srand(seme);
+	vector<int> kljucevi(velicina), novi(velicina < 1000 ? velicina : 1000);
+	for (int& k : kljucevi)
+		k = slucajanKljuc() & ~1;
+	for (int& k : novi)
+		k = slucajanKljuc() | 1;
+
+	// opseg za brisanje pokriva 1% prostora kljuceva
+	const int sirinaOpsega = (1 << 30) / 100;
+	int pocetakOpsega = slucajanKljuc() % ((1 << 30) - sirinaOpsega);
+	vector<int> uOpsegu;
+	for (int k : kljucevi)
+		if (k >= pocetakOpsega && k <= pocetakOpsega + sirinaOpsega)
+			uOpsegu.push_back(k);
+
+	// opsezi za brojanje su iste sirine kao opseg za brisanje
+	vector<int> opsezi(16);
+	for (int& k : opsezi)
+		k = slucajanKljuc() % ((1 << 30) - sirinaOpsega);
+
+	if (format == CSV)
+		o << "skup,scenario,velicina,uzoraka,min_ms,medijana_ms,p99_ms,prosek_ms,stddev_ms,medijana_ciklusa" << endl;
+	else
+		o << "[";
+
+	bool prvi = true;
+	auto ispisiZa = [&](const char* naziv, const char* scenario, const StatistikaMerenja& st)
+	{
+		if (format == CSV)
+			o << naziv << ',' << scenario << ',' << velicina << ',' << st.uzoraka << ','
+			<< st.min << ',' << st.medijana << ',' << st.p99 << ',' << st.prosek << ',' << st.stdDev << ',' << (long long)st.ciklusiMedijana << endl;
+		else
+		{
+			o << (prvi ? "" : ",") << endl << "  {\"skup\": \"" << naziv << "\", \"scenario\": \"" << scenario
+				<< "\", \"velicina\": " << velicina << ", \"uzoraka\": " << st.uzoraka
+				<< ", \"min_ms\": " << st.min << ", \"medijana_ms\": " << st.medijana << ", \"p99_ms\": " << st.p99
+				<< ", \"prosek_ms\": " << st.prosek << ", \"stddev_ms\": " << st.stdDev << ", \"medijana_ciklusa\": " << (long long)st.ciklusiMedijana << "}";
+		}
+
+		prvi = false;
+	};
+	auto ispisi = [&](int vrsta, const char* scenario, const StatistikaMerenja& st) { ispisiZa(FabrikaSkupova::Naziv(vrsta), scenario, st); };
+
+	// isti upiti jedan po jedan i kao serija - pola postoji u skupu
+	vector<int> upiti(novi.size());
+	for (size_t i = 0; i < novi.size(); i++)
+		upiti[i] = i % 2 ? novi[i] : kljucevi[i];
+	unique_ptr<bool[]> odgovori(new bool[upiti.size()]);
+
+	for (int vrsta : izabrane)
+	{
+		Skup* skup = FabrikaSkupova::Napravi(vrsta);
+		Skup* drugi = FabrikaSkupova::Napravi(vrsta);
+		if (skup == nullptr || drugi == nullptr)
+		{
+			delete skup;
+			delete drugi;
+			continue;
+		}
+
+		auto formiraj = [&]() { for (int k : kljucevi) skup->UmetniElement(k); };
+
+		ispisi(vrsta, "formiranje", meri([&]() { skup->IsprazniSkup(); }, formiraj, nullptr));
+
+		// cela serija odjednom, sortirana na jednoj ili na svim nitima
+		ispisi(vrsta, "formiranje_serijom", meri([&]() { skup->IsprazniSkup(); },
+			[&]() { skup->UmetniElemente(kljucevi.data(), velicina); }, nullptr));
+
+		ispisi(vrsta, "formiranje_paralelno", meri([&]() { skup->IsprazniSkup(); },
+			[&]() { skup->UmetniElementeParalelno(kljucevi.data(), velicina); }, nullptr));
+
+		skup->IsprazniSkup();
+		formiraj();
+
+		ispisi(vrsta, "umetanje", meri(nullptr,
+			[&]() { for (int k : novi) skup->UmetniElement(k); },
+			[&]() { for (int k : novi) skup->ObrisiElement(k); }));
+
+		ispisi(vrsta, "brisanje", meri(nullptr,
+			[&]() { for (size_t i = 0; i < novi.size(); i++) skup->ObrisiElement(kljucevi[i]); },
+			[&]() { for (size_t i = 0; i < novi.size(); i++) skup->UmetniElement(kljucevi[i]); }));
+
+		ispisi(vrsta, "brisanje_serijom", meri(nullptr,
+			[&]() { skup->ObrisiElemente(kljucevi.data(), (int)novi.size()); },
+			[&]() { skup->UmetniElemente(kljucevi.data(), (int)novi.size()); }));
+
+		volatile int pronadjeno = 0;
+		ispisi(vrsta, "pretraga", meri(nullptr,
+			[&]() { for (int k : upiti) pronadjeno = pronadjeno + skup->PostojanjeElementa(k); },
+			nullptr));
+
+		ispisi(vrsta, "pretraga_serijom", meri(nullptr,
+			[&]() { skup->PostojanjeElemenata(upiti.data(), upiti.size(), odgovori.get()); },
+			nullptr));
+
+		ispisi(vrsta, "brisanje_opsega", meri(nullptr,
+			[&]() { skup->ObrisiOpsegVrednosti(pocetakOpsega, pocetakOpsega + sirinaOpsega); },
+			[&]() { for (int k : uOpsegu) skup->UmetniElement(k); }));
+
+		// pretraga posle mnogo uskih brisanja opsega - spajanje delova stabla ne sme da mu poveca visinu
+		for (int k : novi)
+			skup->ObrisiOpsegVrednosti(k, k + sirinaOpsega / 100);
+		ispisi(vrsta, "pretraga_posle_brisanja_opsega", meri(nullptr,
+			[&]() { for (int k : upiti) pronadjeno = pronadjeno + skup->PostojanjeElementa(k); },
+			nullptr));
+		skup->IsprazniSkup();
+		formiraj();
+
+		// BrojUOpsegu naspram obilaska svih elemenata za iste opsege
+		volatile int izbrojano = 0;
+		ispisi(vrsta, "brojanje_opsega", meri(nullptr,
+			[&]() { for (int k : opsezi) izbrojano = izbrojano + skup->BrojUOpsegu(k, k + sirinaOpsega); },
+			nullptr));
+
+		ispisi(vrsta, "brojanje_obilaskom", meri(nullptr,
+			[&]() { for (int k : opsezi) for (auto c = skup->NapraviKursor(); c->Vazeci(); c->Sledeci()) izbrojano = izbrojano + (c->Kljuc() >= k && c->Kljuc() <= k + sirinaOpsega); },
+			nullptr));
+
+		// rang i izbor samo za stabla sa statistikom poretka - bez nje je svaki upit obilazak
+		BSTSkup* stablo = dynamic_cast<BSTSkup*>(skup);
+		if (stablo != nullptr && stablo->StatistikaPoretka() && stablo->BrojElemenata() > 0)
+			ispisi(vrsta, "rang_izbor", meri(nullptr,
+				[&]() { for (size_t i = 0; i < novi.size(); i++) izbrojano = izbrojano + stablo->Rang(novi[i]) + stablo->Izbor((int)(i % stablo->BrojElemenata())); },
+				nullptr));
+
+		// drugi skup deli polovinu elemenata sa prvim
+		for (size_t i = 0; i < kljucevi.size(); i += 2)
+			drugi->UmetniElement(i % 4 == 0 ? kljucevi[i] : kljucevi[i] | 1);
+
+		Skup* rezultat = nullptr;
+		ispisi(vrsta, "razlika", meri(nullptr,
+			[&]() { rezultat = *skup - *drugi; },
+			[&]() { delete rezultat; rezultat = nullptr; }));
+
+		ispisi(vrsta, "razlika_paralelna", meri(nullptr,
+			[&]() { rezultat = skup->RazlikaParalelno(*drugi); },
+			[&]() { delete rezultat; rezultat = nullptr; }));
+
+		// binarni snimak skupa i formiranje drugog skupa iz njega
+		stringstream snimak;
+		ispisi(vrsta, "snimanje", meri([&]() { snimak.str(""); },
+			[&]() { skup->Sacuvaj(snimak); }, nullptr));
+
+		ispisi(vrsta, "ucitavanje_snimka", meri([&]() { snimak.clear(); snimak.seekg(0); },
+			[&]() { drugi->Ucitaj(snimak); }, nullptr));
+
+		delete skup;
+		delete drugi;
+	}
+
+	// snimak istih kljuceva se mapira iz privremene datoteke - kontrolni zbir cita ceo snimak, pa se meri i bez njega
+	const char* datoteka = "dz_analiza.snimak";
+	if (vrste.empty() && velicina > 0)
+	{
+		{
+			NizSkup izvor;
+			izvor.UmetniElemente(kljucevi.data(), velicina);
+			ofstream fajl(datoteka, ios::binary);
+			izvor.Sacuvaj(fajl);
+		}
+
+		try
+		{
+			ispisiZa("mapirani", "otvaranje", meri(nullptr, [&]() { MapiraniSkup m(datoteka); }, nullptr));
+			ispisiZa("mapirani", "otvaranje_bez_zbira", meri(nullptr, [&]() { MapiraniSkup m(datoteka, false); }, nullptr));
+
+			MapiraniSkup mapirani(datoteka);
+			volatile int pronadjeno = 0;
+
+			ispisiZa("mapirani", "pretraga", meri(nullptr,
+				[&]() { for (int k : upiti) pronadjeno = pronadjeno + mapirani.PostojanjeElementa(k); },
+				nullptr));
+
+			ispisiZa("mapirani", "pretraga_serijom", meri(nullptr,
+				[&]() { mapirani.PostojanjeElemenata(upiti.data(), upiti.size(), odgovori.get()); },
+				nullptr));
+
+			ispisiZa("mapirani", "brojanje_opsega", meri(nullptr,
+				[&]() { for (int k : opsezi) pronadjeno = pronadjeno + mapirani.BrojUOpsegu(k, k + sirinaOpsega); },
+				nullptr));
+		}
+		catch (Skup::Greska) {} // datoteka nije mogla da se napise
+
+		remove(datoteka);
+	}
+
+	if (format == JSON)
+		o << endl << "]" << endl;
+}
+
+/* za svaki broj niti: samo citaoci, citaoci uz jednog pisca i samo pisci; citaoci traze
+kljuceve skupa i isto toliko nepostojecih, a pisac umece pa brise isti neparan kljuc, tako
+da velicina skupa ostaje ista - propusnost je broj operacija u sekundi svih niti zajedno */
+void AnalizatorPerformansi::PokreniVisenitno(ostream & o, Format format, int velicina, int seme, int maksNiti, const vector<int>& vrste)
+{
+	vector<int> izabrane;
+	for (int v = 1; v <= FabrikaSkupova::BrojVrsta(); v++)
+		if (FabrikaSkupova::Konkurentna(v) && (vrste.empty() || find(vrste.begin(), vrste.end(), v) != vrste.end()))
+			izabrane.push_back(v);
+
+	srand(seme);
+	vector<int> kljucevi(velicina);
+	for (int& k : kljucevi)
+		k = slucajanKljuc() & ~1;
+
+	if (format == CSV)
+		o << "skup,scenario,niti,citanja_u_sekundi,pisanja_u_sekundi" << endl;
+	else
+		o << "[";
+
+	bool prvi = true;
+	for (int vrsta : izabrane)
+	{
+		for (int niti = 1; niti <= maksNiti; niti++)
+		{
+			const char* scenariji[] = { "citanje", "citanje_uz_pisca", "pisanje" };
+			int citalaca[] = { niti, niti, 0 };
+			int pisaca[] = { 0, 1, niti };
+
+			for (int sc = 0; sc < 3; sc++)
+			{
+				Skup* skup = FabrikaSkupova::Napravi(vrsta);
+				skup->UmetniElemente(kljucevi.data(), velicina);
+
+				int ukupno = citalaca[sc] + pisaca[sc];
+				atomic<bool> kraj(false);
+				vector<long long> operacija(ukupno, 0);
+				vector<thread> radnici;
+
+				auto radi = [&](int i)
+				{
+					bool pisac = i >= citalaca[sc];
+					uint32_t x = (uint32_t)seme * 2654435761u + 2 * i + 1;
+					long long broj = 0;
+
+					// kraj se proverava na svakih 64 operacije da provera ne bi bila deo merenja
+					while (!kraj.load(memory_order_relaxed))
+					{
+						for (int j = 0; j < 64; j++)
+						{
+							x ^= x << 13;
+							x ^= x >> 17;
+							x ^= x << 5;
+
+							if (pisac)
+							{
+								int k = (int)(x & 0x3FFFFFFF) | 1;
+								skup->UmetniElement(k);
+								skup->ObrisiElement(k);
+							}
+							else
+								skup->PostojanjeElementa(kljucevi[x % kljucevi.size()] | (int)(x >> 31));
+						}
+
+						broj += pisac ? 128 : 64;
+					}
+
+					operacija[i] = broj;
+				};
+
+				for (int i = 0; i < ukupno; i++)
+					radnici.emplace_back(radi, i);
+
+				PerformanceCalculator pc;
+				pc.start();
+				this_thread::sleep_for(chrono::milliseconds(konfiguracija.trajanjeMs));
+				kraj = true;
+				for (thread& t : radnici)
+					t.join();
+				pc.stop();
+
+				double sekundi = pc.elapsedMillis() / 1000;
+				long long citanja = 0, pisanja = 0;
+				for (int i = 0; i < ukupno; i++)
+					(i < citalaca[sc] ? citanja : pisanja) += operacija[i];
+
+				if (format == CSV)
+					o << FabrikaSkupova::Naziv(vrsta) << ',' << scenariji[sc] << ',' << niti << ',' << citanja / sekundi << ',' << pisanja / sekundi << endl;
+				else
+					o << (prvi ? "" : ",") << endl << "  {\"skup\": \"" << FabrikaSkupova::Naziv(vrsta) << "\", \"scenario\": \"" << scenariji[sc]
+					<< "\", \"niti\": " << niti << ", \"citanja_u_sekundi\": " << citanja / sekundi << ", \"pisanja_u_sekundi\": " << pisanja / sekundi << "}";
+
+				prvi = false;
+				delete skup;
+			}
+		}
+	}
+
+	if (format == JSON)
+		o << endl << "]" << endl;
+}
+
+#pragma endregion
+
+#pragma region "BSTSkup.cpp"
+
+BSTSkup::Cvor * BSTSkup::MorrisObilazak::Sledeci()
+{
+	while (tekuci != nullptr)
+	{
+		if (tekuci->levi == nullptr) // nema levog podstabla - cvor je na redu
+		{
+			Cvor* rez = tekuci;
+			tekuci = tekuci->desni;
+			return rez;
+		}
+
+		// inorder prethodnik tekuceg cvora
+		Cvor* prethodnik = tekuci->levi;
+		while (prethodnik->desni != nullptr && prethodnik->desni != tekuci)
+			prethodnik = prethodnik->desni;
+
+		if (prethodnik->desni == nullptr) // prvi dolazak - postavljanje privremene veze i silazak levo
+		{
+			prethodnik->desni = tekuci;
+			tekuci = tekuci->levi;
+		}
+		else // levo podstablo je obidjeno - uklanjanje privremene veze
+		{
+			prethodnik->desni = nullptr;
+
+			Cvor* rez = tekuci;
+			tekuci = tekuci->desni;
+			return rez;
+		}
+	}
+
+	return nullptr;
+}
+
+void BSTSkup::kopiraj(const BSTSkup & s)
+{
+	statistikaPoretka = s.statistikaPoretka;
+
+	Cvor* p = s.koren;
+	if (p == nullptr) // nema svrhe kopiranje
+		return;
+
+	Cvor* noviKoren, *tmp;
+
+	Stek<Cvor*> stek1, stek2;
+
+	// kopiranje korena
+	noviKoren = bazen.Napravi(p->kljuc); // const za rezultat
+	noviKoren->velicina = p->velicina;
+	tmp = noviKoren;				// promenljiva za obradu
+	n++;
+
+	stek1.Dodaj(p);
+	stek2.Dodaj(tmp);
+
+	// preorder kopiranje stabla
+	while (!stek1.Prazan() && !stek2.Prazan())
+	{
+		p = stek1.Uzmi();	// originalno stablo
+		tmp = stek2.Uzmi();	// kopirano stablo
+
+		while (p != nullptr)
+		{
+			if (p->levi != nullptr)	// kopiranje levog podstabla
+			{
+				tmp->levi = bazen.Napravi(p->levi->kljuc);
+				tmp->levi->velicina = p->levi->velicina;
+				n++;
+			}
+			if (p->desni != nullptr) // kopiranje desnog podstabla
+			{
+				tmp->desni = bazen.Napravi(p->desni->kljuc);
+				tmp->desni->velicina = p->desni->velicina;
+				n++;
+			}
+
+			if (p->desni != nullptr) // dodavanje na stek desnog cvora
+			{
+				stek1.Dodaj(p->desni);
+				stek2.Dodaj(tmp->desni);
+			}
+
+			// skretanje ulevo
+			p = p->levi;
+			tmp = tmp->levi;
+		}
+	}
+
+	koren = noviKoren;
+}
+
+void BSTSkup::premesti(BSTSkup & s)
+{
+	koren = s.koren;
+	n = s.n;
+	statistikaPoretka = s.statistikaPoretka;
+	bazen.Zameni(s.bazen);
+
+	s.koren = nullptr;
+	s.n = 0;
+}
+
+// svi cvorovi su u bazenu skupa, pa se stablo brise vracanjem blokova bez obilaska cvorova
+void BSTSkup::obrisi()
+{
+	bazen.OslobodiSve();
+
+	koren = nullptr;
+	n = 0;
+}
+
+BSTSkup::Cvor * BSTSkup::pronadiElement(int k, Cvor* koren) const
+{
+	Cvor* tmp = koren;
+
+	// pretrazivanje
+	while (tmp != nullptr)
+	{
+		BROJI_POSETU(1);
+		// skretanje u levo i desno podstablo
+		if (k == tmp->kljuc) // element je pronaden
+			return tmp;
+		else if (k < tmp->kljuc)
+			tmp = tmp->levi;
+		else
+			tmp = tmp->desni;
+	}
+
+	return nullptr;
+}
+
+void BSTSkup::pisi(ostream & o) const
+{
+	Obilazak obilazak(koren, n);
+
+	for (const Cvor* tmp = obilazak.Sledeci(); tmp != nullptr; tmp = obilazak.Sledeci())
+		o << tmp->kljuc << ' ';
+}
+
+BSTSkup & BSTSkup::operator=(const BSTSkup & s)
+{
+	if (this != &s) { obrisi(); kopiraj(s); }
+
+	return *this;
+}
+
+BSTSkup & BSTSkup::operator=(BSTSkup && s)
+{
+	if (this != &s) { obrisi(); premesti(s); }
+
+	return *this;
+}
+
+bool BSTSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	return pronadiElement(k, koren) != nullptr;
+}
+
+void BSTSkup::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	NavigacijaStabla<Cvor>::Postoje(koren, kljucevi, broj, rezultat);
+}
+
+BSTSkup & BSTSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	Cvor* p = koren;   // trenutni
+	Cvor* q = nullptr; // prethodni cvor
+
+					   // pretraga i pamcenje prethodnog cvora
+	while (p != nullptr)
+	{
+		q = p;
+		BROJI_POSETU(1);
+
+		// skretanje u levo i desno podstablo
+		if (k < p->kljuc)
+			p = p->levi;
+		else if (k > p->kljuc)
+			p = p->desni;
+		else // element je vec u skupu
+			return *this;
+	}
+
+	Cvor* novi = bazen.Napravi(k);
+
+	// pakovanje novog cvora na prethodnik
+	if (q == nullptr) // slucaj da je stablo prazno
+		koren = novi;
+	else
+		if (k < q->kljuc)
+			q->levi = novi;
+		else
+			q->desni = novi;
+
+	// tek kada je izvesno da je kljuc nov, svi preci dobijaju po jedan cvor
+	if (statistikaPoretka)
+		for (p = koren; p != novi; p = k < p->kljuc ? p->levi : p->desni)
+			p->velicina++;
+
+	// brojac broja elemenata
+	n++;
+
+	return *this;
+}
+
+// balansirano stablo od sortiranog niza bez ponavljanja: sredina je koren, a polovine podstabla
+BSTSkup::Cvor * BSTSkup::izgradi(const int * niz, int od, int doo)
+{
+	if (od > doo)
+		return nullptr;
+
+	int sredina = od + (doo - od) / 2;
+
+	Cvor* p = bazen.Napravi(niz[sredina]);
+	p->velicina = doo - od + 1;
+	p->levi = izgradi(niz, od, sredina - 1);
+	p->desni = izgradi(niz, sredina + 1, doo);
+
+	return p;
+}
+
+/* mala serija u veliko stablo se umece element po element, a inace se postojeci kljucevi
+spajaju sa sortiranom serijom i stablo se gradi iznova - balansirano i u linearnom vremenu */
+BSTSkup & BSTSkup::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	if (broj <= 0)
+		return *this;
+
+	if (broj < n / 16)
+	{
+		for (int i = 0; i < broj; i++)
+			UmetniElement(niz[i]);
+
+		return *this;
+	}
+
+	vector<int> kljucevi(niz, niz + broj);
+	pripremiSeriju(kljucevi);
+
+	if (n > 0)
+	{
+		vector<int> postojeci, spojeni;
+		postojeci.reserve(n);
+
+		{
+			MorrisObilazak obilazak(koren);
+			for (Cvor* tmp = obilazak.Sledeci(); tmp != nullptr; tmp = obilazak.Sledeci())
+				postojeci.push_back(tmp->kljuc);
+		}
+
+		spojeni.reserve(postojeci.size() + kljucevi.size());
+		set_union(postojeci.begin(), postojeci.end(), kljucevi.begin(), kljucevi.end(), back_inserter(spojeni));
+		kljucevi.swap(spojeni);
+	}
+
+	obrisi();
+	koren = izgradi(kljucevi.data(), 0, (int)kljucevi.size() - 1);
+	n = (int)kljucevi.size();
+
+	return *this;
+}
+
+BSTSkup & BSTSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	Cvor* p = koren;   // trenutni
+	Cvor* q = nullptr; // prethodni
+
+					   // pretrazivanje na zadati kljuc i pamcenje prethodnika
+	while (p != nullptr && p->kljuc != k)
+	{
+		q = p;
+		BROJI_POSETU(2);
+
+		// skretanje u levo i desno podstablo
+		if (k < p->kljuc)
+			p = p->levi;
+		else
+			p = p->desni;
+	}
+
+	if (p == nullptr) // element za brisanje ne postoji u skupu
+		return *this;
+
+	if (statistikaPoretka)
+		for (Cvor* t = koren; t != p; t = k < t->kljuc ? t->levi : t->desni)
+			t->velicina--;
+
+	Cvor* rp = nullptr; // posto se p brise, rp je cvor koji je sin od p
+
+	if (p->levi == nullptr) // levi sin p ne postoji, rp je desni ako postoji
+		rp = p->desni;
+	else if (p->desni == nullptr) // desni sin p ne postoji, rp je levi jer postoji
+		rp = p->levi;
+	else // p ima i levog i desnog sina
+	{
+		Cvor* f = nullptr, *s = nullptr;
+
+		f = p;
+		rp = f->desni;
+		s = rp->levi;
+
+		while (s != nullptr)
+		{
+			f = rp;
+			rp = s;
+			s = rp->levi;
+
+			f->velicina--; // sledbenik napusta podstablo od f
+		}
+
+		if (f != p)
+		{
+			f->levi = rp->desni;
+			rp->desni = p->desni;
+		}
+
+		rp->levi = p->levi;
+		rp->velicina = p->velicina - 1;
+	}
+
+	if (q == nullptr) // prethodnik ne postoji
+		koren = rp;
+	else if (p == q->levi) // p je bio levi sin oca
+		q->levi = rp;
+	else if (p == q->desni) // p je bio desni sin oca
+		q->desni = rp;
+
+	bazen.Unisti(p);
+
+	// brojac elemenata
+	n--;
+
+	return *this;
+}
+
+/* deli stablo na cvorove sa kljucem manjim od k (ili manjim ili jednakim ako je ukljuciK)
+i ostale; prolazi se samo put od korena do k, pa je slozenost O(h) */
+void BSTSkup::razdvoji(Cvor * p, int k, bool ukljuciK, Cvor *& levo, Cvor *& desno)
+{
+	Cvor** l = &levo;	// mesto gde se kaci sledeci cvor levog dela
+	Cvor** d = &desno;	// mesto gde se kaci sledeci cvor desnog dela
+
+	while (p != nullptr)
+	{
+		if (p->kljuc < k || (ukljuciK && p->kljuc == k)) // p i njegovo levo podstablo idu levo
+		{
+			*l = p;
+			l = &p->desni;
+			p = p->desni;
+		}
+		else // p i njegovo desno podstablo idu desno
+		{
+			*d = p;
+			d = &p->levi;
+			p = p->levi;
+		}
+	}
+
+	*l = nullptr;
+	*d = nullptr;
+}
+
+/* spajanje dva stabla kod kojih su svi kljucevi levog manji od svih kljuceva desnog; najveci
+cvor levog stabla se izdvaja i postaje koren sa oba stabla kao decom, pa je visina rezultata
+najvise max(h1, h2) + 1 umesto h1 + h2 kod kacenja desnog stabla na dno leve kicme */
+BSTSkup::Cvor * BSTSkup::spoji(Cvor * levo, Cvor * desno)
+{
+	if (levo == nullptr)
+		return desno;
+	if (desno == nullptr)
+		return levo;
+
+	Cvor** mesto = &levo; // mesto na kome visi najveci cvor levog stabla
+	while ((*mesto)->desni != nullptr)
+	{
+		(*mesto)->velicina--;
+		mesto = &(*mesto)->desni;
+	}
+
+	Cvor* p = *mesto;
+	*mesto = p->levi;
+
+	p->levi = levo;
+	p->desni = desno;
+	p->velicina = 1 + velicina(levo) + velicina(desno);
+
+	return p;
+}
+
+// brisanje podstabla bez steka - leva deca se rotacijama prebacuju udesno; vraca broj obrisanih cvorova
+int BSTSkup::obrisiPodstablo(Cvor * p)
+{
+	int obrisano = 0;
+
+	while (p != nullptr)
+	{
+		if (p->levi != nullptr) // rotacija udesno
+		{
+			Cvor* l = p->levi;
+			p->levi = l->desni;
+			l->desni = p;
+			p = l;
+		}
+		else
+		{
+			Cvor* sledeci = p->desni;
+			bazen.Unisti(p);
+			p = sledeci;
+			obrisano++;
+		}
+	}
+
+	return obrisano;
+}
+
+// velicina se postavlja uvek, pa je stablo posle izgradnje spremno i za statistiku poretka
+BSTSkup::Cvor * BSTSkup::izListe(Cvor *& lista, int broj)
+{
+	return NavigacijaStabla<Cvor>::IzListe(lista, broj, [](Cvor* p, int velicina) { p->velicina = velicina; });
+}
+
+/* stablo se deli na tri dela (< min, [min, max], > max), srednji deo se brise, a
+krajnji spajaju - slozenost je O(h + k) bez obzira na sirinu opsega */
+BSTSkup & BSTSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	Cvor *manji, *ostali, *opseg, *veci;
+
+	razdvoji(koren, min, false, manji, ostali);
+	razdvoji(ostali, max, true, opseg, veci);
+
+	n -= obrisiPodstablo(opseg);
+
+	// razdvajanje menja podstabla samo cvorovima na desnoj kicmi levog i levoj kicmi desnog dela, a spoji odrzava velicine sam
+	if (statistikaPoretka)
+	{
+		popraviKicmu(manji, true);
+		popraviKicmu(veci, false);
+	}
+
+	koren = spoji(manji, veci);
+
+	return *this;
+}
+
+// velicine cvorova na levoj ili desnoj kicmi podstabla se racunaju ponovo odozdo - O(h)
+void BSTSkup::popraviKicmu(Cvor * p, bool desna)
+{
+	Stek<Cvor*> kicma;
+	for (; p != nullptr; p = desna ? p->desni : p->levi)
+		kicma.Dodaj(p);
+
+	while (!kicma.Prazan())
+	{
+		p = kicma.Uzmi();
+		p->velicina = 1 + velicina(p->levi) + velicina(p->desni);
+	}
+}
+
+// bez statistike poretka rang se dobija obilaskom - O(n)
+int BSTSkup::rang(int k, bool ukljuciK) const
+{
+	int r = 0;
+
+	if (!statistikaPoretka)
+	{
+		Obilazak obilazak(koren, n);
+		for (const Cvor* p = obilazak.Sledeci(); p != nullptr && (p->kljuc < k || (ukljuciK && p->kljuc == k)); p = obilazak.Sledeci())
+			r++;
+
+		return r;
+	}
+
+	for (Cvor* p = koren; p != nullptr; )
+	{
+		if (p->kljuc < k || (ukljuciK && p->kljuc == k)) // p i njegovo levo podstablo su pre k
+		{
+			r += velicina(p->levi) + 1;
+			p = p->desni;
+		}
+		else
+			p = p->levi;
+	}
+
+	return r;
+}
+
+int BSTSkup::Rang(int k) const
+{
+	return rang(k, false);
+}
+
+int BSTSkup::Izbor(int i) const
+{
+	if (i < 0 || i >= n)
+		throw INDEKS;
+
+	if (!statistikaPoretka)
+	{
+		Obilazak obilazak(koren, n);
+		const Cvor* p = obilazak.Sledeci();
+		for (; i > 0; i--)
+			p = obilazak.Sledeci();
+
+		return p->kljuc;
+	}
+
+	Cvor* p = koren;
+	while (i != velicina(p->levi))
+	{
+		if (i < velicina(p->levi))
+			p = p->levi;
+		else
+		{
+			i -= velicina(p->levi) + 1;
+			p = p->desni;
+		}
+	}
+
+	return p->kljuc;
+}
+
+// sa statistikom poretka kvantil je tacan
+int BSTSkup::kvantil(int i, int delova) const
+{
+	if (!statistikaPoretka)
+		return Skup::kvantil(i, delova);
+
+	return Izbor((int)((int64_t)n * i / delova));
+}
+
+int BSTSkup::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (!statistikaPoretka)
+		return Skup::BrojUOpsegu(min, max);
+
+	if (min > max)
+		throw INDEKS;
+
+	return rang(max, true) - rang(min, false);
+}
+
+void BSTSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	obrisi();
+	koren = nullptr;
+	n = 0;
+}
+
+// rezultat se gradi iz sortiranih kljuceva odjednom - balansiran i u linearnom vremenu
+BSTSkup * BSTSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+/* malo drugo stablo se oduzima brisanjem kljuc po kljuc; inace se stablo ispravlja u listu,
+iz nje se jednim prolazom uz obilazak drugog stabla izbacuju zajednicki cvorovi, a ostatak se
+ponovo slaze u balansirano stablo - sve u O(n + m) i bez nove memorije */
+BSTSkup & BSTSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	const BSTSkup* drugi = dynamic_cast<const BSTSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+	{
+		razlikaUMestuKursorima(s2);
+		return *this;
+	}
+
+	if (drugi == this)
+	{
+		obrisi();
+		return *this;
+	}
+
+	if (n == 0 || drugi->n == 0)
+		return *this;
+
+	Obilazak obilazak(drugi->koren, drugi->n);
+
+	if (pojedinacno(drugi->n, n))
+	{
+		for (const Cvor* p = obilazak.Sledeci(); p != nullptr; p = obilazak.Sledeci())
+			ObrisiElement(p->kljuc);
+
+		return *this;
+	}
+
+	Cvor* lista = NavigacijaStabla<Cvor>::UListu(koren);
+	Cvor** mesto = &lista;
+	const Cvor* p2 = obilazak.Sledeci();
+
+	while (*mesto != nullptr && p2 != nullptr)
+	{
+		if ((*mesto)->kljuc < p2->kljuc)
+			mesto = &(*mesto)->desni;
+		else if ((*mesto)->kljuc > p2->kljuc)
+			p2 = obilazak.Sledeci();
+		else // izbacivanje iz liste
+		{
+			Cvor* p = *mesto;
+			*mesto = p->desni;
+			bazen.Unisti(p);
+			n--;
+
+			p2 = obilazak.Sledeci();
+		}
+	}
+
+	koren = izListe(lista, n);
+
+	return *this;
+}
+
+BSTSkup * BSTSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	const BSTSkup* drugi = dynamic_cast<const BSTSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<BSTSkup*>(spojiKursorima(s2, delovi));
+
+	vector<int> kljucevi;
+	spajanje(*drugi, delovi, [&kljucevi](int k) { kljucevi.push_back(k); return true; });
+
+	// kljucevi stizu sortirani i bez ponavljanja, pa se stablo gradi direktno - balansirano i u O(n)
+	BSTSkup* rezultat = new BSTSkup(statistikaPoretka);
+	rezultat->koren = rezultat->izgradi(kljucevi.data(), 0, (int)kljucevi.size() - 1);
+	rezultat->n = (int)kljucevi.size();
+
+	return rezultat;
+}
+
+bool BSTSkup::postoji(const Skup & s2, int delovi) const
+{
+	const BSTSkup* drugi = dynamic_cast<const BSTSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return postojiKursorima(s2, delovi);
+
+	bool nadjen = false;
+	spajanje(*drugi, delovi, [&nadjen](int) { nadjen = true; return false; });
+
+	return nadjen;
+}
+
+void BSTSkup::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<BSTSkup*>(s));
+	delete s;
+}
+
+
+BSTSkup * BSTSkup::prazan() const
+{
+	return new BSTSkup(statistikaPoretka);
+}
+
+unique_ptr<Skup::Kursor> BSTSkup::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new KursorStabla<Cvor>(koren));
+}
+
+// pozicija je adresa cvora, a kraj nullptr
+uintptr_t BSTSkup::pozicijaNeManjegOd(int k) const
+{
+	return (uintptr_t)NavigacijaStabla<Cvor>::NeManjiOd(koren, k);
+}
+
+uintptr_t BSTSkup::pozicijaKraja() const
+{
+	return 0;
+}
+
+uintptr_t BSTSkup::sledecaPozicija(uintptr_t p) const
+{
+	return (uintptr_t)NavigacijaStabla<Cvor>::Sledbenik(koren, (const Cvor*)p);
+}
+
+uintptr_t BSTSkup::prethodnaPozicija(uintptr_t p) const
+{
+	return (uintptr_t)NavigacijaStabla<Cvor>::Prethodnik(koren, (const Cvor*)p);
+}
+
+int BSTSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return ((const Cvor*)p)->kljuc;
+}
+
+#pragma endregion
+
+#pragma region "DCLLSkup.cpp"
+
+int DCLLSkup::Indeks::slucajanNivo()
+{
+	// xorshift32
+	int n = 0;
+
+	while (n < MAKS_NIVO)
+	{
+		stanje ^= stanje << 13;
+		stanje ^= stanje >> 17;
+		stanje ^= stanje << 5;
+
+		if ((stanje & 3) != 0)
+			break;
+
+		n++;
+	}
+
+	return n;
+}
+
+// veze do NIVOA_U_CVORU nivoa su u samom cvoru, a visi cvorovi dobijaju niz za sve nivoe iz drugog bazena
+DCLLSkup::Indeks::Cvor * DCLLSkup::Indeks::napravi(Element * e, int n)
+{
+	return cvorovi.Napravi(e, n, n > NIVOA_U_CVORU ? veze.Napravi()->sledeci : nullptr);
+}
+
+void DCLLSkup::Indeks::unisti(Cvor * x)
+{
+	if (x->nivo > NIVOA_U_CVORU)
+		veze.Unisti(reinterpret_cast<Veze*>(x->sledeci));
+	cvorovi.Unisti(x);
+}
+
+// za svaki nivo pamti poslednji cvor indeksa ciji je broj manji od k
+DCLLSkup::Indeks::Cvor * DCLLSkup::Indeks::prethodnici(int k, Cvor ** azuriranje)
+{
+	Cvor* x = &glava;
+
+	for (int i = nivo - 1; i >= 0; i--)
+	{
+		while (x->sledeci[i] != nullptr && x->sledeci[i]->element->broj < k)
+			x = x->sledeci[i];
+
+		azuriranje[i] = x;
+	}
+
+	return x;
+}
+
+DCLLSkup::Element * DCLLSkup::Indeks::Prethodnik(int k) const
+{
+	const Cvor* x = &glava;
+
+	for (int i = nivo - 1; i >= 0; i--)
+		while (x->sledeci[i] != nullptr && x->sledeci[i]->element->broj < k)
+		{
+			x = x->sledeci[i];
+			BROJI_POSETU(1);
+		}
+
+	return x->element;
+}
+
+void DCLLSkup::Indeks::Dodaj(Element * e)
+{
+	int n = slucajanNivo();
+	if (n == 0) // element ostaje samo u listi
+		return;
+
+	Cvor* azuriranje[MAKS_NIVO];
+	prethodnici(e->broj, azuriranje);
+
+	for (; nivo < n; nivo++)
+		azuriranje[nivo] = &glava;
+
+	Cvor* novi = napravi(e, n);
+	for (int i = 0; i < n; i++)
+	{
+		novi->sledeci[i] = azuriranje[i]->sledeci[i];
+		azuriranje[i]->sledeci[i] = novi;
+	}
+}
+
+void DCLLSkup::Indeks::Ukloni(int k)
+{
+	Cvor* azuriranje[MAKS_NIVO];
+	Cvor* x = prethodnici(k, azuriranje);
+
+	x = nivo > 0 ? x->sledeci[0] : nullptr;
+	if (x == nullptr || x->element->broj != k) // element nije u indeksu
+		return;
+
+	for (int i = 0; i < x->nivo; i++)
+		azuriranje[i]->sledeci[i] = x->sledeci[i];
+
+	unisti(x);
+
+	while (nivo > 0 && glava.sledeci[nivo - 1] == nullptr)
+		nivo--;
+}
+
+void DCLLSkup::Indeks::UkloniOpseg(int min, int max)
+{
+	Cvor* azuriranje[MAKS_NIVO];
+	Cvor* x = prethodnici(min, azuriranje);
+
+	x = nivo > 0 ? x->sledeci[0] : nullptr;
+
+	while (x != nullptr && x->element->broj <= max)
+	{
+		Cvor* sledeci = x->sledeci[0];
+
+		for (int i = 0; i < x->nivo; i++)
+			azuriranje[i]->sledeci[i] = x->sledeci[i];
+
+		unisti(x);
+		x = sledeci;
+	}
+
+	while (nivo > 0 && glava.sledeci[nivo - 1] == nullptr)
+		nivo--;
+}
+
+// indeks se gradi jednim prolazom kroz listu dodavanjem na kraj svakog nivoa
+void DCLLSkup::Indeks::Izgradi()
+{
+	Isprazni();
+
+	Cvor* poslednji[MAKS_NIVO];
+	for (int i = 0; i < MAKS_NIVO; i++)
+		poslednji[i] = &glava;
+
+	for (Element* e = glava.element->sledeci; e != glava.element; e = e->sledeci)
+	{
+		int n = slucajanNivo();
+		if (n == 0)
+			continue;
+
+		Cvor* novi = napravi(e, n);
+		for (int i = 0; i < n; i++)
+		{
+			poslednji[i]->sledeci[i] = novi;
+			poslednji[i] = novi;
+		}
+
+		if (n > nivo)
+			nivo = n;
+	}
+}
+
+// cvorovi su trivijalno unistivi, pa se indeks oslobadja u O(broj blokova) bez prolaska kroz cvorove
+void DCLLSkup::Indeks::Isprazni()
+{
+	cvorovi.OslobodiSve();
+	veze.OslobodiSve();
+
+	for (int i = 0; i < MAKS_NIVO; i++)
+		glava.sledeci[i] = nullptr;
+	nivo = 0;
+}
+
+StatistikaAlokacije DCLLSkup::Indeks::Statistika() const
+{
+	StatistikaAlokacije s = cvorovi.Statistika();
+	s += veze.Statistika();
+
+	return s;
+}
+
+void DCLLSkup::kopiraj(const DCLLSkup & ss)
+{
+	pZaglavlje = new Zaglavlje(0, nullptr, nullptr);
+	indeks = nullptr;
+
+	Element *original = ss.pZaglavlje->sledeci;
+	Element *prethodni = pZaglavlje;
+	Element *trenutni = nullptr;
+
+	// dodavanje elementa po element uz pamcenje zadnjeg pokazivaca
+	while (original != ss.pZaglavlje)
+	{
+		trenutni = bazen.Napravi(original->broj);
+
+		trenutni->prethodni = prethodni;
+		prethodni->sledeci = trenutni;
+
+		prethodni = trenutni;
+		original = original->sledeci;
+
+		azurirajZaglavlje(DODAVANJE);
+	}
+
+	if (trenutni != nullptr) // zadnji element pokazuje na zaglavlje i obrnuto
+	{
+		trenutni->sledeci = pZaglavlje;
+		pZaglavlje->prethodni = trenutni;
+	}
+	else // zaglavlje pokazuje samo na sebe jer nema elemenata
+	{
+		pZaglavlje->sledeci = pZaglavlje;
+		pZaglavlje->prethodni = pZaglavlje;
+	}
+
+	if (ss.indeks != nullptr)
+	{
+		indeks = new Indeks(pZaglavlje);
+		indeks->Izgradi();
+	}
+}
+
+void DCLLSkup::premesti(DCLLSkup & s)
+{
+	pZaglavlje = s.pZaglavlje;
+	indeks = s.indeks;
+	bazen.Zameni(s.bazen);
+
+	s.pZaglavlje = nullptr;
+	s.indeks = nullptr;
+}
+
+void DCLLSkup::obrisi()
+{
+	if (pZaglavlje == nullptr) // sadrzaj je premesten u drugi skup
+		return;
+
+	// elementi se ne obilaze - vracaju se celi blokovi bazena
+	bazen.OslobodiSve();
+
+	delete pZaglavlje;
+	delete indeks;
+
+	pZaglavlje = nullptr;
+	indeks = nullptr;
+}
+
+inline void DCLLSkup::inicijalizuj(bool indeksiran)
+{
+	// formiranje zaglavlja ulancane liste sa brojem 0 kao brojem clanova skupa
+	pZaglavlje = new Zaglavlje(0, nullptr, nullptr);
+	pZaglavlje->sledeci = pZaglavlje;
+	pZaglavlje->prethodni = pZaglavlje;
+
+	indeks = indeksiran ? new Indeks(pZaglavlje) : nullptr;
+}
+
+inline void DCLLSkup::azurirajZaglavlje(Operacija op)
+{
+	// azuriranje broja elemenata u zaglavlju
+	if (op == DODAVANJE)
+		pZaglavlje->broj++;
+	else
+		pZaglavlje->broj--;
+}
+
+inline DCLLSkup::Element* DCLLSkup::dodajNakon(Element * p, int k)
+{
+	Element* novi = bazen.Napravi(k);
+	Element* sledeci = p->sledeci;
+
+	novi->prethodni = p;
+	novi->sledeci = sledeci;
+
+	p->sledeci = novi;
+	sledeci->prethodni = novi;
+
+	azurirajZaglavlje(DODAVANJE);
+
+	return novi;
+}
+
+inline DCLLSkup::Element* DCLLSkup::dodajPre(Element * p, int k)
+{
+	Element* novi = bazen.Napravi(k);
+	Element* prethodni = p->prethodni;
+
+	novi->prethodni = prethodni;
+	novi->sledeci = p;
+
+	p->prethodni = novi;
+	prethodni->sledeci = novi;
+
+	azurirajZaglavlje(DODAVANJE);
+
+	return novi;
+}
+
+inline void DCLLSkup::izbaci(Element * p)
+{
+	// prespajanje
+	p->prethodni->sledeci = p->sledeci;
+	p->sledeci->prethodni = p->prethodni;
+
+	azurirajZaglavlje(BRISANJE);
+
+	bazen.Unisti(p);
+}
+
+// prvi element liste koji nije manji od k, ili zaglavlje ako takav ne postoji
+DCLLSkup::Element * DCLLSkup::prviNeManjiOd(int k) const
+{
+	// bez indeksa pretraga krece od zaglavlja, a sa indeksom od najblizeg indeksiranog prethodnika
+	Element* trenutni = indeks != nullptr ? indeks->Prethodnik(k) : pZaglavlje;
+	trenutni = trenutni->sledeci;
+
+	while (trenutni != pZaglavlje && trenutni->broj < k)
+	{
+		trenutni = trenutni->sledeci;
+		BROJI_POSETU(1);
+	}
+
+	return trenutni;
+}
+
+void DCLLSkup::pisi(ostream & o) const
+{
+	Element* tmp = pZaglavlje->sledeci;
+
+	while (tmp != pZaglavlje)
+	{
+		o << tmp->broj << ' ';
+		tmp = tmp->sledeci;
+	}
+}
+
+DCLLSkup & DCLLSkup::operator=(const DCLLSkup & s)
+{
+	if (this != &s) { obrisi(); kopiraj(s); }
+
+	return *this;
+}
+
+DCLLSkup & DCLLSkup::operator=(DCLLSkup && s)
+{
+	if (this != &s) { obrisi(); premesti(s); }
+
+	return *this;
+}
+
+bool DCLLSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	if (pZaglavlje->broj == 0) // skup je prazan, nema svrhe da se pretrazuje
+		return false;
+
+	Element* el = prviNeManjiOd(k);
+
+	return el != pZaglavlje && el->broj == k;
+}
+
+DCLLSkup & DCLLSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	Element* trenutni = prviNeManjiOd(k);
+
+	// ako postoji nista, u suprotnom dodavanje ispred prvog veceg (ili zaglavlja)
+	if (trenutni != pZaglavlje && trenutni->broj == k)
+		return *this;
+
+	Element* novi = dodajPre(trenutni, k);
+
+	if (indeks != nullptr)
+		indeks->Dodaj(novi);
+
+	return *this;
+}
+
+/* sortirana serija se umece jednim prolazom kroz listu; indeks se posle toga gradi iznova,
+osim kada je serija mala u odnosu na skup pa je jeftinije umetati kroz indeks */
+DCLLSkup & DCLLSkup::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	if (broj <= 0)
+		return *this;
+
+	if (indeks != nullptr && broj < pZaglavlje->broj / 16)
+	{
+		for (int i = 0; i < broj; i++)
+			UmetniElement(niz[i]);
+
+		return *this;
+	}
+
+	vector<int> kljucevi(niz, niz + broj);
+	pripremiSeriju(kljucevi);
+
+	Element* trenutni = pZaglavlje->sledeci;
+
+	for (int k : kljucevi)
+	{
+		while (trenutni != pZaglavlje && trenutni->broj < k)
+			trenutni = trenutni->sledeci;
+
+		if (trenutni == pZaglavlje || trenutni->broj != k)
+			dodajPre(trenutni, k);
+	}
+
+	if (indeks != nullptr)
+		indeks->Izgradi();
+
+	return *this;
+}
+
+DCLLSkup & DCLLSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	Element *trenutni = prviNeManjiOd(k);
+
+	// nebrisanje zaglavlja
+	if (trenutni != pZaglavlje && trenutni->broj == k)
+	{
+		if (indeks != nullptr)
+			indeks->Ukloni(k);
+
+		izbaci(trenutni);
+	}
+
+	return *this;
+}
+
+// elementi opsega su uzastopni u listi, pa se od prvog ne manjeg od min brise dok se ne prede max
+DCLLSkup & DCLLSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	Element* tmp = prviNeManjiOd(min);
+
+	if (indeks != nullptr)
+		indeks->UkloniOpseg(min, max);
+
+	while (tmp != pZaglavlje && tmp->broj <= max)
+	{
+		Element* sledeci = tmp->sledeci;
+		izbaci(tmp);
+		tmp = sledeci;
+	}
+
+	return *this;
+}
+
+int DCLLSkup::BrojElemenata() const
+{
+	return pZaglavlje->broj;
+}
+
+// indeks ima sopstvene bazene, pa se njegova memorija prijavljuje zajedno sa elementima liste
+StatistikaAlokacije DCLLSkup::StatistikaAlokatora() const
+{
+	StatistikaAlokacije s = bazen.Statistika();
+	if (indeks != nullptr)
+		s += indeks->Statistika();
+
+	return s;
+}
+
+void DCLLSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	bool indeksiran = indeks != nullptr;
+
+	obrisi();
+	inicijalizuj(indeksiran);
+}
+
+// elementi razlike se dodaju na kraj rezultata, bez ponovnog prolaza kroz listu za svaki
+DCLLSkup* DCLLSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+/* zajednicki elementi se izbacuju jednim prolazom kroz obe liste; indeksiran skup mali
+drugi skup oduzima kroz indeks, a posle prolaza se indeks gradi iznova */
+DCLLSkup & DCLLSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	const DCLLSkup* drugi = dynamic_cast<const DCLLSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+	{
+		razlikaUMestuKursorima(s2);
+		return *this;
+	}
+
+	if (drugi == this)
+	{
+		IsprazniSkup();
+		return *this;
+	}
+
+	if (indeks != nullptr && pojedinacno(drugi->pZaglavlje->broj, pZaglavlje->broj))
+	{
+		for (Element* p2 = drugi->pZaglavlje->sledeci; p2 != drugi->pZaglavlje; p2 = p2->sledeci)
+			ObrisiElement(p2->broj);
+
+		return *this;
+	}
+
+	Element* p1 = pZaglavlje->sledeci;
+	Element* p2 = drugi->pZaglavlje->sledeci;
+	bool izbacen = false;
+
+	while (p1 != pZaglavlje && p2 != drugi->pZaglavlje)
+	{
+		if (p1->broj < p2->broj)
+			p1 = p1->sledeci;
+		else if (p1->broj > p2->broj)
+			p2 = p2->sledeci;
+		else
+		{
+			Element* sledeci = p1->sledeci;
+			izbaci(p1);
+			izbacen = true;
+
+			p1 = sledeci;
+			p2 = p2->sledeci;
+		}
+	}
+
+	if (indeks != nullptr && izbacen)
+		indeks->Izgradi();
+
+	return *this;
+}
+
+// rezultat se puni dodavanjem na kraj liste, a indeks se gradi jednim prolazom na kraju
+DCLLSkup * DCLLSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	const DCLLSkup* drugi = dynamic_cast<const DCLLSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<DCLLSkup*>(spojiKursorima(s2, delovi));
+
+	DCLLSkup* rezultat = new DCLLSkup();
+	spajanje(*drugi, delovi, [rezultat](int k) { rezultat->dodajPre(rezultat->pZaglavlje, k); return true; });
+
+	if (indeks != nullptr)
+	{
+		rezultat->indeks = new Indeks(rezultat->pZaglavlje);
+		rezultat->indeks->Izgradi();
+	}
+
+	return rezultat;
+}
+
+bool DCLLSkup::postoji(const Skup & s2, int delovi) const
+{
+	const DCLLSkup* drugi = dynamic_cast<const DCLLSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return postojiKursorima(s2, delovi);
+
+	bool nadjen = false;
+	spajanje(*drugi, delovi, [&nadjen](int) { nadjen = true; return false; });
+
+	return nadjen;
+}
+
+void DCLLSkup::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<DCLLSkup*>(s));
+	delete s;
+}
+
+
+DCLLSkup * DCLLSkup::prazan() const
+{
+	return new DCLLSkup(indeks != nullptr);
+}
+
+unique_ptr<Skup::Kursor> DCLLSkup::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new Kursor(this));
+}
+
+// pozicija je adresa elementa, a kraj zaglavlje
+uintptr_t DCLLSkup::pozicijaNeManjegOd(int k) const
+{
+	return (uintptr_t)prviNeManjiOd(k);
+}
+
+uintptr_t DCLLSkup::pozicijaKraja() const
+{
+	return (uintptr_t)pZaglavlje;
+}
+
+uintptr_t DCLLSkup::sledecaPozicija(uintptr_t p) const
+{
+	return (uintptr_t)((const Element*)p)->sledeci;
+}
+
+uintptr_t DCLLSkup::prethodnaPozicija(uintptr_t p) const
+{
+	return (uintptr_t)((const Element*)p)->prethodni;
+}
+
+int DCLLSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return ((const Element*)p)->broj;
+}
+
+void DCLLSkup::Kursor::Trazi(int k)
+{
+	if (!Vazeci() || tekuci->broj >= k)
+		return;
+
+	if (skup->indeks != nullptr)
+		tekuci = skup->prviNeManjiOd(k);
+	else
+		while (tekuci != skup->pZaglavlje && tekuci->broj < k)
+			tekuci = tekuci->sledeci;
+}
+
+#pragma endregion
+
+#pragma region "AVLSkup.cpp"
+
+void AVLSkup::kopiraj(const AVLSkup & s)
+{
+	koren = kopirajPodstablo(s.koren);
+	n = s.n;
+}
+
+void AVLSkup::premesti(AVLSkup & s)
+{
+	koren = s.koren;
+	n = s.n;
+	bazen.Zameni(s.bazen);
+
+	s.koren = nullptr;
+	s.n = 0;
+}
+
+void AVLSkup::obrisi()
+{
+	bazen.OslobodiSve();
+
+	koren = nullptr;
+	n = 0;
+}
+
+// rekurzija je bezbedna jer je visina AVL stabla najvise ~1.44 log(n)
+AVLSkup::Cvor * AVLSkup::kopirajPodstablo(const Cvor * p)
+{
+	if (p == nullptr)
+		return nullptr;
+
+	Cvor* novi = bazen.Napravi(p->kljuc, kopirajPodstablo(p->levi), kopirajPodstablo(p->desni));
+	novi->visina = p->visina;
+
+	return novi;
+}
+
+inline void AVLSkup::azurirajVisinu(Cvor * p)
+{
+	int vl = visina(p->levi), vd = visina(p->desni);
+	p->visina = (vl > vd ? vl : vd) + 1;
+}
+
+AVLSkup::Cvor * AVLSkup::rotirajLevo(Cvor * p)
+{
+	Cvor* d = p->desni;
+
+	p->desni = d->levi;
+	d->levi = p;
+
+	azurirajVisinu(p);
+	azurirajVisinu(d);
+
+	return d;
+}
+
+AVLSkup::Cvor * AVLSkup::rotirajDesno(Cvor * p)
+{
+	Cvor* l = p->levi;
+
+	p->levi = l->desni;
+	l->desni = p;
+
+	azurirajVisinu(p);
+	azurirajVisinu(l);
+
+	return l;
+}
+
+// vraca novi koren podstabla nakon sto se ispravi eventualna neuravnotezenost za 2
+AVLSkup::Cvor * AVLSkup::balansiraj(Cvor * p)
+{
+	azurirajVisinu(p);
+
+	int balans = visina(p->levi) - visina(p->desni);
+
+	if (balans > 1) // levo podstablo je previsoko
+	{
+		if (visina(p->levi->levi) < visina(p->levi->desni)) // levo-desni slucaj
+			p->levi = rotirajLevo(p->levi);
+
+		return rotirajDesno(p);
+	}
+	else if (balans < -1) // desno podstablo je previsoko
+	{
+		if (visina(p->desni->desni) < visina(p->desni->levi)) // desno-levi slucaj
+			p->desni = rotirajDesno(p->desni);
+
+		return rotirajLevo(p);
+	}
+
+	return p;
+}
+
+AVLSkup::Cvor * AVLSkup::umetni(Cvor * p, int k, bool & umetnut)
+{
+	if (p == nullptr)
+	{
+		umetnut = true;
+		return bazen.Napravi(k);
+	}
+
+	BROJI_POSETU(2);
+	if (k < p->kljuc)
+		p->levi = umetni(p->levi, k, umetnut);
+	else if (k > p->kljuc)
+		p->desni = umetni(p->desni, k, umetnut);
+	else // element je vec u skupu
+		return p;
+
+	return umetnut ? balansiraj(p) : p;
+}
+
+AVLSkup::Cvor * AVLSkup::izbaciMinimum(Cvor * p, Cvor *& minimum)
+{
+	if (p->levi == nullptr)
+	{
+		minimum = p;
+		return p->desni;
+	}
+
+	p->levi = izbaciMinimum(p->levi, minimum);
+
+	return balansiraj(p);
+}
+
+AVLSkup::Cvor * AVLSkup::izbaci(Cvor * p, int k, bool & izbacen)
+{
+	if (p == nullptr) // element ne postoji u skupu
+		return nullptr;
+
+	BROJI_POSETU(2);
+	if (k < p->kljuc)
+		p->levi = izbaci(p->levi, k, izbacen);
+	else if (k > p->kljuc)
+		p->desni = izbaci(p->desni, k, izbacen);
+	else
+	{
+		izbacen = true;
+
+		Cvor* levi = p->levi;
+		Cvor* desni = p->desni;
+		bazen.Unisti(p);
+
+		if (desni == nullptr)
+			return levi;
+
+		// sledbenik (najmanji u desnom podstablu) zauzima mesto obrisanog cvora
+		Cvor* sledbenik;
+		desni = izbaciMinimum(desni, sledbenik);
+
+		sledbenik->levi = levi;
+		sledbenik->desni = desni;
+
+		return balansiraj(sledbenik);
+	}
+
+	return izbacen ? balansiraj(p) : p;
+}
+
+void AVLSkup::pisi(ostream & o) const
+{
+	Stek<Cvor*> stek;
+	Cvor* tmp = koren;
+
+	while (1)
+	{
+		while (tmp)
+		{
+			stek.Dodaj(tmp);
+			tmp = tmp->levi;
+		}
+
+		if (!stek.Prazan())
+		{
+			tmp = stek.Uzmi();
+			o << tmp->kljuc << ' ';
+			tmp = tmp->desni;
+		}
+		else
+			break;
+	}
+}
+
+AVLSkup & AVLSkup::operator=(const AVLSkup & s)
+{
+	if (this != &s) { obrisi(); kopiraj(s); }
+
+	return *this;
+}
+
+AVLSkup & AVLSkup::operator=(AVLSkup && s)
+{
+	if (this != &s) { obrisi(); premesti(s); }
+
+	return *this;
+}
+
+bool AVLSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	Cvor* tmp = koren;
+
+	while (tmp != nullptr)
+	{
+		BROJI_POSETU(1);
+		if (k == tmp->kljuc)
+			return true;
+		else if (k < tmp->kljuc)
+			tmp = tmp->levi;
+		else
+			tmp = tmp->desni;
+	}
+
+	return false;
+}
+
+void AVLSkup::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	NavigacijaStabla<Cvor>::Postoje(koren, kljucevi, broj, rezultat);
+}
+
+AVLSkup & AVLSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	bool umetnut = false;
+	koren = umetni(koren, k, umetnut);
+
+	if (umetnut)
+		n++;
+
+	return *this;
+}
+
+// kao kod BSTSkup, s tim sto se cvorovima odmah postavljaju visine
+AVLSkup::Cvor * AVLSkup::izgradi(const int * niz, int od, int doo)
+{
+	if (od > doo)
+		return nullptr;
+
+	int sredina = od + (doo - od) / 2;
+
+	Cvor* p = bazen.Napravi(niz[sredina], izgradi(niz, od, sredina - 1), izgradi(niz, sredina + 1, doo));
+	azurirajVisinu(p);
+
+	return p;
+}
+
+AVLSkup::Cvor * AVLSkup::izListe(Cvor *& lista, int broj)
+{
+	return NavigacijaStabla<Cvor>::IzListe(lista, broj, [](Cvor* p, int) { azurirajVisinu(p); });
+}
+
+// mala serija se umece element po element (O(k log n)), a velika spajanjem i izgradnjom u O(n + k)
+AVLSkup & AVLSkup::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	if (broj <= 0)
+		return *this;
+
+	if (broj < n / 16)
+	{
+		for (int i = 0; i < broj; i++)
+			UmetniElement(niz[i]);
+
+		return *this;
+	}
+
+	vector<int> kljucevi(niz, niz + broj);
+	pripremiSeriju(kljucevi);
+
+	if (n > 0)
+	{
+		vector<int> postojeci, spojeni;
+		postojeci.reserve(n);
+
+		Stek<Cvor*> stek;
+		Cvor* tmp = koren;
+
+		while (tmp != nullptr || !stek.Prazan())
+		{
+			for (; tmp != nullptr; tmp = tmp->levi)
+				stek.Dodaj(tmp);
+
+			tmp = stek.Uzmi();
+			postojeci.push_back(tmp->kljuc);
+			tmp = tmp->desni;
+		}
+
+		spojeni.reserve(postojeci.size() + kljucevi.size());
+		set_union(postojeci.begin(), postojeci.end(), kljucevi.begin(), kljucevi.end(), back_inserter(spojeni));
+		kljucevi.swap(spojeni);
+	}
+
+	obrisi();
+	koren = izgradi(kljucevi.data(), 0, (int)kljucevi.size() - 1);
+	n = (int)kljucevi.size();
+
+	return *this;
+}
+
+AVLSkup & AVLSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	bool izbacen = false;
+	koren = izbaci(koren, k, izbacen);
+
+	if (izbacen)
+		n--;
+
+	return *this;
+}
+
+// brisu se samo elementi koji postoje u opsegu, pa je slozenost O(k log n), a ne O((max - min) log n)
+AVLSkup & AVLSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	const Cvor* p = NavigacijaStabla<Cvor>::NeManjiOd(koren, min);
+
+	while (p != nullptr && p->kljuc <= max)
+	{
+		int k = p->kljuc;
+		ObrisiElement(k);
+
+		if (k == max) // zastita od prekoracenja za k + 1
+			break;
+
+		p = NavigacijaStabla<Cvor>::NeManjiOd(koren, k + 1);
+	}
+
+	return *this;
+}
+
+void AVLSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	obrisi();
+}
+
+AVLSkup * AVLSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+// isto kao kod BSTSkup: kljuc po kljuc u O(m log n) ili preko liste u O(n + m)
+AVLSkup & AVLSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	const AVLSkup* drugi = dynamic_cast<const AVLSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+	{
+		razlikaUMestuKursorima(s2);
+		return *this;
+	}
+
+	if (drugi == this)
+	{
+		obrisi();
+		return *this;
+	}
+
+	if (n == 0 || drugi->n == 0)
+		return *this;
+
+	KursorStabla<Cvor> kursor(drugi->koren);
+
+	if (pojedinacno(drugi->n, n))
+	{
+		for (; kursor.Vazeci(); kursor.Sledeci())
+			ObrisiElement(kursor.Kljuc());
+
+		return *this;
+	}
+
+	Cvor* lista = NavigacijaStabla<Cvor>::UListu(koren);
+	Cvor** mesto = &lista;
+
+	while (*mesto != nullptr && kursor.Vazeci())
+	{
+		if ((*mesto)->kljuc < kursor.Kljuc())
+			mesto = &(*mesto)->desni;
+		else if ((*mesto)->kljuc > kursor.Kljuc())
+			kursor.Sledeci();
+		else
+		{
+			Cvor* p = *mesto;
+			*mesto = p->desni;
+			bazen.Unisti(p);
+			n--;
+
+			kursor.Sledeci();
+		}
+	}
+
+	koren = izListe(lista, n);
+
+	return *this;
+}
+
+AVLSkup * AVLSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	const AVLSkup* drugi = dynamic_cast<const AVLSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<AVLSkup*>(spojiKursorima(s2, delovi));
+
+	vector<int> kljucevi;
+	spajanje(*drugi, delovi, [&kljucevi](int k) { kljucevi.push_back(k); return true; });
+
+	// kljucevi stizu sortirani i bez ponavljanja, pa se stablo gradi direktno - balansirano i u O(n)
+	AVLSkup* rezultat = new AVLSkup();
+	rezultat->koren = rezultat->izgradi(kljucevi.data(), 0, (int)kljucevi.size() - 1);
+	rezultat->n = (int)kljucevi.size();
+
+	return rezultat;
+}
+
+bool AVLSkup::postoji(const Skup & s2, int delovi) const
+{
+	const AVLSkup* drugi = dynamic_cast<const AVLSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return postojiKursorima(s2, delovi);
+
+	bool nadjen = false;
+	spajanje(*drugi, delovi, [&nadjen](int) { nadjen = true; return false; });
+
+	return nadjen;
+}
+
+void AVLSkup::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<AVLSkup*>(s));
+	delete s;
+}
+
+
+AVLSkup * AVLSkup::prazan() const
+{
+	return new AVLSkup();
+}
+
+unique_ptr<Skup::Kursor> AVLSkup::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new KursorStabla<Cvor>(koren));
+}
+
+// pozicija je adresa cvora, a kraj nullptr
+uintptr_t AVLSkup::pozicijaNeManjegOd(int k) const
+{
+	return (uintptr_t)NavigacijaStabla<Cvor>::NeManjiOd(koren, k);
+}
+
+uintptr_t AVLSkup::pozicijaKraja() const
+{
+	return 0;
+}
+
+uintptr_t AVLSkup::sledecaPozicija(uintptr_t p) const
+{
+	return (uintptr_t)NavigacijaStabla<Cvor>::Sledbenik(koren, (const Cvor*)p);
+}
+
+uintptr_t AVLSkup::prethodnaPozicija(uintptr_t p) const
+{
+	return (uintptr_t)NavigacijaStabla<Cvor>::Prethodnik(koren, (const Cvor*)p);
+}
+
+int AVLSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return ((const Cvor*)p)->kljuc;
+}
+
+#pragma endregion
+
+#pragma region "JezgraNiza.cpp"
+
+static size_t neManjiOdSkalarno(const int* a, size_t n, int k)
+{
+	// polovljenje bez grananja - uslov postaje uslovni prenos (cmov)
+	const int* p = a;
+	while (n > 1)
+	{
+		size_t pola = n / 2;
+		p = p[pola - 1] < k ? p + pola : p;
+		n -= pola;
+	}
+
+	return p - a + (n == 1 && *p < k);
+}
+
+static size_t razlikaSkalarno(const int* a, size_t na, const int* b, size_t nb, int* izlaz)
+{
+	size_t i = 0, j = 0, n = 0;
+
+	// kljuc se uvek upisuje, a pozicija upisa pomera samo ako ga nema u b
+	while (i < na && j < nb)
+	{
+		int x = a[i], y = b[j];
+		izlaz[n] = x;
+		n += x < y;
+		i += x <= y;
+		j += y <= x;
+	}
+
+	while (i < na)
+		izlaz[n++] = a[i++];
+
+	return n;
+}
+
+static size_t presekSkalarno(const int* a, size_t na, const int* b, size_t nb, int* izlaz)
+{
+	size_t i = 0, j = 0, n = 0;
+
+	while (i < na && j < nb)
+	{
+		int x = a[i], y = b[j];
+		izlaz[n] = x;
+		n += x == y;
+		i += x <= y;
+		j += y <= x;
+	}
+
+	return n;
+}
+
+#ifdef JEZGRA_X86
+
+/* za svaku masku pogodaka permutacija koja pogodjene kljuceve redom prebacuje na pocetak
+vektora; SSE4 permutuje bajtove (pshufb), a AVX2 32-bitne kljuceve (vpermd) */
+struct TabeleSabijanja
+{
+	alignas(16) unsigned char cetiri[16][16];
+	alignas(32) uint32_t osam[256][8];
+
+	TabeleSabijanja()
+	{
+		for (int maska = 0; maska < 16; maska++)
+		{
+			int n = 0;
+			for (int i = 0; i < 4; i++)
+				if (maska & (1 << i))
+				{
+					for (int b = 0; b < 4; b++)
+						cetiri[maska][n * 4 + b] = (unsigned char)(i * 4 + b);
+					n++;
+				}
+			for (; n < 4; n++)
+				for (int b = 0; b < 4; b++)
+					cetiri[maska][n * 4 + b] = 0x80;
+		}
+
+		for (int maska = 0; maska < 256; maska++)
+		{
+			int n = 0;
+			for (int i = 0; i < 8; i++)
+				if (maska & (1 << i))
+					osam[maska][n++] = i;
+			for (; n < 8; n++)
+				osam[maska][n] = 0;
+		}
+	}
+};
+
+static const TabeleSabijanja tabeleSabijanja;
+
+// vektor od 4 kljuca iz a poredi se sa sve 4 rotacije vektora iz b
+__attribute__((target("sse4.2,popcnt")))
+static inline int pogodciSSE4(__m128i va, __m128i vb)
+{
+	__m128i m = _mm_or_si128(
+		_mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+		_mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+
+	return _mm_movemask_ps(_mm_castsi128_ps(m));
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static size_t neManjiOdSSE4(const int* a, size_t n, int k)
+{
+	const int* p = a;
+	while (n > 16)
+	{
+		size_t pola = n / 2;
+		p = p[pola - 1] < k ? p + pola : p;
+		n -= pola;
+	}
+
+	// u poslednjih najvise 16 kljuceva se broje oni manji od k
+	__m128i vk = _mm_set1_epi32(k);
+	size_t manjih = 0, i = 0;
+	for (; i + 4 <= n; i += 4)
+		manjih += _mm_popcnt_u32(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(vk, _mm_loadu_si128((const __m128i*)(p + i))))));
+	for (; i < n; i++)
+		manjih += p[i] < k;
+
+	return p - a + manjih;
+}
+
+/* blok iz a se pomera tek kada je blok iz b stigao do njegovog najveceg kljuca, pa su do tada
+pogoci svih blokova iz b sakupljeni u maski. Vektor se upisuje ceo, a pozicija upisa pomera samo
+za kljuceve koji ostaju; upis zato moze da prepise tekuci blok kada je izlaz sam niz a, pa se
+blok cuva u registru, a sledeci ucitava cim se tekuci zavrsi */
+__attribute__((target("sse4.2,popcnt")))
+static size_t razlikaSSE4(const int* a, size_t na, const int* b, size_t nb, int* izlaz)
+{
+	if (na < 4)
+		return razlikaSkalarno(a, na, b, nb, izlaz);
+
+	size_t i = 0, j = 0, n = 0;
+	int pogodak = 0;
+	__m128i va = _mm_loadu_si128((const __m128i*)a);
+
+	while (j + 4 <= nb)
+	{
+		pogodak |= pogodciSSE4(va, _mm_loadu_si128((const __m128i*)(b + j)));
+
+		int amax = _mm_extract_epi32(va, 3), bmax = b[j + 3];
+		int dalje = amax <= bmax, ostaje = ~pogodak & 15;
+
+		_mm_storeu_si128((__m128i*)(izlaz + n), _mm_shuffle_epi8(va, _mm_load_si128((const __m128i*)tabeleSabijanja.cetiri[ostaje])));
+		n += dalje * _mm_popcnt_u32(ostaje);
+		pogodak &= dalje - 1;
+
+		i += dalje * 4;
+		j += (bmax <= amax) * 4;
+		if (i + 4 > na)
+			break;
+
+		va = _mm_blendv_epi8(va, _mm_loadu_si128((const __m128i*)(a + i)), _mm_set1_epi32(-dalje));
+	}
+
+	// tekuci blok iz a vec ima deo pogodaka, pa se ostatak njegovih kljuceva zavrsava skalarno
+	if (i + 4 <= na)
+	{
+		int blok[4], ostatak[4];
+		_mm_storeu_si128((__m128i*)blok, va);
+
+		size_t broj = 0;
+		for (int t = 0; t < 4; t++)
+			if ((pogodak & (1 << t)) == 0)
+				ostatak[broj++] = blok[t];
+
+		n += razlikaSkalarno(ostatak, broj, b + j, nb - j, izlaz + n);
+		i += 4;
+	}
+
+	return n + razlikaSkalarno(a + i, na - i, b + j, nb - j, izlaz + n);
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static size_t presekSSE4(const int* a, size_t na, const int* b, size_t nb, int* izlaz)
+{
+	size_t i = 0, j = 0, n = 0;
+
+	while (i + 4 <= na && j + 4 <= nb)
+	{
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		int pogodak = pogodciSSE4(va, _mm_loadu_si128((const __m128i*)(b + j)));
+
+		_mm_storeu_si128((__m128i*)(izlaz + n), _mm_shuffle_epi8(va, _mm_load_si128((const __m128i*)tabeleSabijanja.cetiri[pogodak])));
+		n += _mm_popcnt_u32(pogodak);
+
+		int amax = a[i + 3], bmax = b[j + 3];
+		i += (amax <= bmax) * 4;
+		j += (bmax <= amax) * 4;
+	}
+
+	return n + presekSkalarno(a + i, na - i, b + j, nb - j, izlaz + n);
+}
+
+// vektor od 8 kljuceva iz a poredi se sa svih 8 rotacija vektora iz b
+__attribute__((target("avx2,popcnt")))
+static inline int pogodciAVX2(__m256i va, __m256i vb)
+{
+	const __m256i rotacija = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+	__m256i m = _mm256_cmpeq_epi32(va, vb);
+	for (int r = 1; r < 8; r++)
+	{
+		vb = _mm256_permutevar8x32_epi32(vb, rotacija);
+		m = _mm256_or_si256(m, _mm256_cmpeq_epi32(va, vb));
+	}
+
+	return _mm256_movemask_ps(_mm256_castsi256_ps(m));
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t neManjiOdAVX2(const int* a, size_t n, int k)
+{
+	const int* p = a;
+	while (n > 32)
+	{
+		size_t pola = n / 2;
+		p = p[pola - 1] < k ? p + pola : p;
+		n -= pola;
+	}
+
+	__m256i vk = _mm256_set1_epi32(k);
+	size_t manjih = 0, i = 0;
+	for (; i + 8 <= n; i += 8)
+		manjih += _mm_popcnt_u32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vk, _mm256_loadu_si256((const __m256i*)(p + i))))));
+	for (; i < n; i++)
+		manjih += p[i] < k;
+
+	return p - a + manjih;
+}
+
+// isto kao razlikaSSE4, sa blokovima od 8
+__attribute__((target("avx2,popcnt")))
+static size_t razlikaAVX2(const int* a, size_t na, const int* b, size_t nb, int* izlaz)
+{
+	if (na < 8)
+		return razlikaSkalarno(a, na, b, nb, izlaz);
+
+	size_t i = 0, j = 0, n = 0;
+	int pogodak = 0;
+	__m256i va = _mm256_loadu_si256((const __m256i*)a);
+
+	while (j + 8 <= nb)
+	{
+		pogodak |= pogodciAVX2(va, _mm256_loadu_si256((const __m256i*)(b + j)));
+
+		int amax = _mm256_extract_epi32(va, 7), bmax = b[j + 7];
+		int dalje = amax <= bmax, ostaje = ~pogodak & 255;
+
+		_mm256_storeu_si256((__m256i*)(izlaz + n), _mm256_permutevar8x32_epi32(va, _mm256_load_si256((const __m256i*)tabeleSabijanja.osam[ostaje])));
+		n += dalje * _mm_popcnt_u32(ostaje);
+		pogodak &= dalje - 1;
+
+		i += dalje * 8;
+		j += (bmax <= amax) * 8;
+		if (i + 8 > na)
+			break;
+
+		va = _mm256_blendv_epi8(va, _mm256_loadu_si256((const __m256i*)(a + i)), _mm256_set1_epi32(-dalje));
+	}
+
+	if (i + 8 <= na)
+	{
+		int blok[8], ostatak[8];
+		_mm256_storeu_si256((__m256i*)blok, va);
+
+		size_t broj = 0;
+		for (int t = 0; t < 8; t++)
+			if ((pogodak & (1 << t)) == 0)
+				ostatak[broj++] = blok[t];
+
+		n += razlikaSkalarno(ostatak, broj, b + j, nb - j, izlaz + n);
+		i += 8;
+	}
+
+	return n + razlikaSkalarno(a + i, na - i, b + j, nb - j, izlaz + n);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t presekAVX2(const int* a, size_t na, const int* b, size_t nb, int* izlaz)
+{
+	size_t i = 0, j = 0, n = 0;
+
+	while (i + 8 <= na && j + 8 <= nb)
+	{
+		__m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+		int pogodak = pogodciAVX2(va, _mm256_loadu_si256((const __m256i*)(b + j)));
+
+		_mm256_storeu_si256((__m256i*)(izlaz + n), _mm256_permutevar8x32_epi32(va, _mm256_load_si256((const __m256i*)tabeleSabijanja.osam[pogodak])));
+		n += _mm_popcnt_u32(pogodak);
+
+		int amax = a[i + 7], bmax = b[j + 7];
+		i += (amax <= bmax) * 8;
+		j += (bmax <= amax) * 8;
+	}
+
+	return n + presekSkalarno(a + i, na - i, b + j, nb - j, izlaz + n);
+}
+
+#endif
+
+static const JezgraNiza jezgraSkalarna = { "skalarna", neManjiOdSkalarno, razlikaSkalarno, presekSkalarno };
+#ifdef JEZGRA_X86
+static const JezgraNiza jezgraSSE4 = { "sse4", neManjiOdSSE4, razlikaSSE4, presekSSE4 };
+static const JezgraNiza jezgraAVX2 = { "avx2", neManjiOdAVX2, razlikaAVX2, presekAVX2 };
+#endif
+
+const JezgraNiza & JezgraNiza::najbolja()
+{
+#ifdef JEZGRA_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+		return jezgraAVX2;
+	if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+		return jezgraSSE4;
+#endif
+
+	return jezgraSkalarna;
+}
+
+const JezgraNiza *& JezgraNiza::izabrana()
+{
+	static const JezgraNiza* j = &najbolja();
+	return j;
+}
+
+const JezgraNiza & JezgraNiza::Izabrana()
+{
+	return *izabrana();
+}
+
+const JezgraNiza * JezgraNiza::PoNazivu(const string & naziv)
+{
+	if (naziv == jezgraSkalarna.naziv)
+		return &jezgraSkalarna;
+
+#ifdef JEZGRA_X86
+	__builtin_cpu_init();
+	if (naziv == jezgraSSE4.naziv && __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+		return &jezgraSSE4;
+	if (naziv == jezgraAVX2.naziv && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+		return &jezgraAVX2;
+#endif
+
+	return nullptr;
+}
+
+void JezgraNiza::Izaberi(const JezgraNiza & j)
+{
+	izabrana() = &j;
+}
+
+#pragma endregion
+
+#pragma region "NizSkup.cpp"
+
+void NizSkup::spoji() const
+{
+	if (naCekanju.empty())
+		return;
+
+	if (!is_sorted(naCekanju.begin(), naCekanju.end())) // vec sortirana serija (npr. uvoz iz datoteke) se ne sortira
+		sort(naCekanju.begin(), naCekanju.end());
+	naCekanju.erase(unique(naCekanju.begin(), naCekanju.end()), naCekanju.end());
+
+	if (elementi.empty() || naCekanju.front() > elementi.back()) // serija ide na kraj niza
+		elementi.insert(elementi.end(), naCekanju.begin(), naCekanju.end());
+	else
+	{
+		// linearno spajanje dva sortirana niza uz izbacivanje ponavljanja
+		vector<int> spojeni;
+		spojeni.reserve(elementi.size() + naCekanju.size());
+		set_union(elementi.begin(), elementi.end(), naCekanju.begin(), naCekanju.end(), back_inserter(spojeni));
+
+		elementi.swap(spojeni);
+	}
+
+	naCekanju.clear();
+}
+
+void NizSkup::pisi(ostream & o) const
+{
+	spoji();
+
+	for (int k : elementi)
+		o << k << ' ';
+}
+
+bool NizSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	spoji();
+
+	size_t i = neManjiOd(elementi, k);
+
+	return i < elementi.size() && elementi[i] == k;
+}
+
+/* binarne pretrage grupe kljuceva teku uporedo: svi nizovi pretrage imaju istu duzinu, pa u svakom
+koraku svaki kljuc polovi svoj deo bez grananja i unapred ucitava element sledeceg poredjenja */
+void NizSkup::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	spoji();
+
+	const size_t GRUPA = 16;
+	const int* a = elementi.data();
+	const int* p[GRUPA];
+
+	for (size_t od = 0; od < broj; od += GRUPA)
+	{
+		size_t g = min(GRUPA, broj - od);
+		for (size_t i = 0; i < g; i++)
+			p[i] = a;
+
+		size_t n = elementi.size();
+		while (n > 1)
+		{
+			size_t pola = n / 2, ostaje = n - pola;
+			for (size_t i = 0; i < g; i++)
+			{
+				p[i] = p[i][pola - 1] < kljucevi[od + i] ? p[i] + pola : p[i];
+				predUcitaj(p[i] + ostaje / 2);
+			}
+			n = ostaje;
+		}
+
+		for (size_t i = 0; i < g; i++)
+			rezultat[od + i] = n == 1 && *p[i] == kljucevi[od + i];
+	}
+}
+
+NizSkup & NizSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	// rastuci niz umetanja se dodaje direktno na kraj
+	if (naCekanju.empty() && (elementi.empty() || k > elementi.back()))
+	{
+		elementi.push_back(k);
+		return *this;
+	}
+
+	naCekanju.push_back(k);
+
+	if (naCekanju.size() >= MIN_SERIJA && naCekanju.size() >= elementi.size())
+		spoji();
+
+	return *this;
+}
+
+NizSkup & NizSkup::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	if (broj <= 0)
+		return *this;
+
+	naCekanju.insert(naCekanju.end(), niz, niz + broj);
+	spoji();
+
+	return *this;
+}
+
+NizSkup & NizSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	spoji();
+
+	size_t i = neManjiOd(elementi, k);
+	if (i < elementi.size() && elementi[i] == k)
+		elementi.erase(elementi.begin() + i);
+
+	return *this;
+}
+
+NizSkup & NizSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	spoji();
+
+	// elementi opsega cine jedan kontinualni deo niza koji se brise odjednom, pa su
+	// dovoljne dve pretrage granica umesto filtriranja svakog elementa
+	size_t od = neManjiOd(elementi, min);
+	size_t doo = veciOd(elementi, max, od);
+	elementi.erase(elementi.begin() + od, elementi.begin() + doo);
+
+	return *this;
+}
+
+int NizSkup::BrojElemenata() const
+{
+	spoji();
+
+	return (int)elementi.size();
+}
+
+void NizSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	vector<int>().swap(elementi);
+	vector<int>().swap(naCekanju);
+}
+
+NizSkup * NizSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	const NizSkup* drugi = dynamic_cast<const NizSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<NizSkup*>(spojiKursorima(s2, SAMO_PRVI));
+
+	spoji();
+	drugi->spoji();
+
+	NizSkup* rezultat = new NizSkup();
+	rezultat->elementi.resize(elementi.size());
+
+	// linearno spajanje - rezultat je vec sortiran
+	size_t n = JezgraNiza::Izabrana().Razlika(elementi.data(), elementi.size(), drugi->elementi.data(), drugi->elementi.size(), rezultat->elementi.data());
+	rezultat->elementi.resize(n);
+
+	return rezultat;
+}
+
+/* za malo kljuceva drugog skupa pozicija svakog se trazi galopiranjem od prethodne (eksponencijalno,
+pa binarno), sto je O(m log(n / m)), a niz se sabija jednim pomeranjem svakog preostalog dela;
+inace se niz linearno spaja sam u sebe jezgrom razlike */
+NizSkup & NizSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	const NizSkup* drugi = dynamic_cast<const NizSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+	{
+		razlikaUMestuKursorima(s2);
+		return *this;
+	}
+
+	if (drugi == this)
+	{
+		IsprazniSkup();
+		return *this;
+	}
+
+	spoji();
+	drugi->spoji();
+
+	if (!pojedinacno((int)drugi->elementi.size(), (int)elementi.size()))
+	{
+		elementi.resize(JezgraNiza::Izabrana().Razlika(elementi.data(), elementi.size(), drugi->elementi.data(), drugi->elementi.size(), elementi.data()));
+		return *this;
+	}
+
+	size_t velicina = elementi.size();
+	size_t od = 0;		// svi elementi pre od su manji od tekuceg kljuca
+	size_t citanje = 0;	// pocetak dela koji jos nije pomeren
+	size_t upis = 0;
+
+	for (int k : drugi->elementi)
+	{
+		od = galopiraj(elementi, od, k);
+
+		if (od == velicina)
+			break;
+
+		if (elementi[od] == k) // izbacivanje - deo pre njega se pomera na mesto upisa
+		{
+			if (upis != citanje)
+				copy(elementi.begin() + citanje, elementi.begin() + od, elementi.begin() + upis);
+
+			upis += od - citanje;
+			citanje = ++od;
+		}
+	}
+
+	if (upis != citanje)
+	{
+		copy(elementi.begin() + citanje, elementi.end(), elementi.begin() + upis);
+		elementi.resize(upis + (velicina - citanje));
+	}
+
+	return *this;
+}
+
+NizSkup * NizSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	const NizSkup* drugi = dynamic_cast<const NizSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<NizSkup*>(spojiKursorima(s2, delovi));
+
+	spoji();
+	drugi->spoji();
+
+	NizSkup* rezultat = new NizSkup();
+	const vector<int>& a = elementi;
+	const vector<int>& b = drugi->elementi;
+
+	// razlika i presek jezgrom, ostale operacije opstim spajanjem
+	if (delovi == SAMO_PRVI || delovi == OBA)
+	{
+		rezultat->elementi.resize(delovi == OBA ? min(a.size(), b.size()) + JezgraNiza::REZERVA : a.size());
+		const JezgraNiza& j = JezgraNiza::Izabrana();
+		size_t n = delovi == SAMO_PRVI ? j.Razlika(a.data(), a.size(), b.data(), b.size(), rezultat->elementi.data())
+			: j.Presek(a.data(), a.size(), b.data(), b.size(), rezultat->elementi.data());
+		rezultat->elementi.resize(n);
+	}
+	else
+		spajanje(*drugi, delovi, [rezultat](int k) { rezultat->elementi.push_back(k); return true; });
+
+	return rezultat;
+}
+
+bool NizSkup::postoji(const Skup & s2, int delovi) const
+{
+	const NizSkup* drugi = dynamic_cast<const NizSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return postojiKursorima(s2, delovi);
+
+	spoji();
+	drugi->spoji();
+
+	bool nadjen = false;
+	spajanje(*drugi, delovi, [&nadjen](int) { nadjen = true; return false; });
+
+	return nadjen;
+}
+
+void NizSkup::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<NizSkup*>(s));
+	delete s;
+}
+
+
+size_t NizSkup::galopiraj(const vector<int>& niz, size_t od, int k)
+{
+	size_t korak = 1, proba = od;
+
+	// svi elementi pre od su manji od k
+	while (proba < niz.size() && niz[proba] < k)
+	{
+		od = proba + 1;
+		proba = od + korak;
+		korak *= 2;
+	}
+
+	size_t doo = proba + 1 < niz.size() ? proba + 1 : niz.size();
+
+	return od + JezgraNiza::Izabrana().NeManjiOd(niz.data() + od, doo - od, k);
+}
+
+NizSkup * NizSkup::prazan() const
+{
+	return new NizSkup();
+}
+
+unique_ptr<Skup::Kursor> NizSkup::NapraviKursor() const
+{
+	spoji();
+
+	return unique_ptr<Skup::Kursor>(new Kursor(elementi));
+}
+
+// pozicija je indeks u spojenom nizu; serija na cekanju se spaja cim se iterator napravi
+uintptr_t NizSkup::pozicijaNeManjegOd(int k) const
+{
+	spoji();
+
+	return neManjiOd(elementi, k);
+}
+
+uintptr_t NizSkup::pozicijaKraja() const
+{
+	spoji();
+
+	return elementi.size();
+}
+
+uintptr_t NizSkup::sledecaPozicija(uintptr_t p) const
+{
+	return p + 1;
+}
+
+uintptr_t NizSkup::prethodnaPozicija(uintptr_t p) const
+{
+	return p - 1;
+}
+
+int NizSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return elementi[p];
+}
+
+int NizSkup::kvantil(int i, int delova) const
+{
+	spoji();
+
+	return elementi[elementi.size() * i / delova];
+}
+
+int NizSkup::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (min > max)
+		throw INDEKS;
+
+	spoji();
+
+	size_t od = neManjiOd(elementi, min);
+
+	return (int)(veciOd(elementi, max, od) - od);
+}
+
+#pragma endregion
+
+#pragma region "BitmapSkup.cpp"
+
+inline int BitmapSkup::Kontejner::brojBitova(uint64_t w)
+{
+#if defined(__GNUC__)
+	return __builtin_popcountll(w);
+#else
+	int b = 0;
+	for (; w != 0; w &= w - 1)
+		b++;
+	return b;
+#endif
+}
+
+inline int BitmapSkup::Kontejner::nulaNaKraju(uint64_t w)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(w);
+#else
+	int b = 0;
+	for (; (w & 1) == 0; w >>= 1)
+		b++;
+	return b;
+#endif
+}
+
+inline int BitmapSkup::Kontejner::nulaNaPocetku(uint64_t w)
+{
+#if defined(__GNUC__)
+	return __builtin_clzll(w);
+#else
+	int b = 0;
+	for (; (w & (1ULL << 63)) == 0; w <<= 1)
+		b++;
+	return b;
+#endif
+}
+
+// postavljanje bitova [od, doo] - unutrasnje reci se postavljaju cele
+void BitmapSkup::Kontejner::postaviBitove(vector<uint64_t>& reci, int od, int doo)
+{
+	int prva = od >> 6, poslednja = doo >> 6;
+	uint64_t maskaPrve = ~0ULL << (od & 63);
+	uint64_t maskaPoslednje = ~0ULL >> (63 - (doo & 63));
+
+	if (prva == poslednja)
+		reci[prva] |= maskaPrve & maskaPoslednje;
+	else
+	{
+		reci[prva] |= maskaPrve;
+		for (int i = prva + 1; i < poslednja; i++)
+			reci[i] = ~0ULL;
+		reci[poslednja] |= maskaPoslednje;
+	}
+}
+
+// brisanje bitova [od, doo] - unutrasnje reci se brisu cele; vraca broj obrisanih bitova
+int BitmapSkup::Kontejner::obrisiBitove(vector<uint64_t>& reci, int od, int doo)
+{
+	int prva = od >> 6, poslednja = doo >> 6;
+	uint64_t maskaPrve = ~0ULL << (od & 63);
+	uint64_t maskaPoslednje = ~0ULL >> (63 - (doo & 63));
+	int obrisano = 0;
+
+	if (prva == poslednja)
+	{
+		uint64_t maska = maskaPrve & maskaPoslednje;
+		obrisano = brojBitova(reci[prva] & maska);
+		reci[prva] &= ~maska;
+	}
+	else
+	{
+		obrisano += brojBitova(reci[prva] & maskaPrve);
+		reci[prva] &= ~maskaPrve;
+
+		for (int i = prva + 1; i < poslednja; i++)
+		{
+			obrisano += brojBitova(reci[i]);
+			reci[i] = 0;
+		}
+
+		obrisano += brojBitova(reci[poslednja] & maskaPoslednje);
+		reci[poslednja] &= ~maskaPoslednje;
+	}
+
+	return obrisano;
+}
+
+int BitmapSkup::Kontejner::brojIntervala() const
+{
+	if (tip == INTERVALI)
+		return (int)intervali.size();
+
+	int intervala = 0;
+
+	if (tip == NIZ)
+	{
+		for (size_t i = 0; i < niz.size(); i++)
+			if (i == 0 || niz[i] != niz[i - 1] + 1)
+				intervala++;
+	}
+	else
+	{
+		// interval pocinje na svakom postavljenom bitu ciji prethodnik nije postavljen
+		uint64_t prenos = 0;
+		for (int i = 0; i < BROJ_RECI; i++)
+		{
+			uint64_t w = reci[i];
+			intervala += brojBitova(w & ~((w << 1) | prenos));
+			prenos = w >> 63;
+		}
+	}
+
+	return intervala;
+}
+
+// intervali se napustaju cim postanu skuplji od niza ili bitmape
+void BitmapSkup::Kontejner::proveriIntervale()
+{
+	int cenaOstalih = broj <= MAKS_NIZ ? 2 * broj : 2 * BROJ_RECI * 4;
+
+	if (4 * (int)intervali.size() > cenaOstalih)
+	{
+		if (broj <= MAKS_NIZ)
+			uNiz();
+		else
+			uBitmapu();
+	}
+}
+
+void BitmapSkup::Kontejner::uBitmapu()
+{
+	if (tip == BITMAPA)
+		return;
+
+	vector<uint64_t> b(BROJ_RECI, 0);
+
+	if (tip == NIZ)
+		for (uint16_t v : niz)
+			b[v >> 6] |= 1ULL << (v & 63);
+	else
+		for (const Interval& in : intervali)
+			postaviBitove(b, in.pocetak, in.kraj);
+
+	reci.swap(b);
+	vector<uint16_t>().swap(niz);
+	vector<Interval>().swap(intervali);
+	tip = BITMAPA;
+}
+
+void BitmapSkup::Kontejner::uNiz()
+{
+	if (tip == NIZ)
+		return;
+
+	vector<uint16_t> a;
+	a.reserve(broj);
+	ZaSvaki([&a](uint16_t v) { a.push_back(v); });
+
+	niz.swap(a);
+	vector<uint64_t>().swap(reci);
+	vector<Interval>().swap(intervali);
+	tip = NIZ;
+}
+
+void BitmapSkup::Kontejner::uIntervale()
+{
+	if (tip == INTERVALI)
+		return;
+
+	vector<Interval> in;
+	ZaSvaki([&in](uint16_t v)
+	{
+		if (!in.empty() && v == in.back().kraj + 1)
+			in.back().kraj = v;
+		else
+			in.push_back(Interval{ v, v });
+	});
+
+	intervali.swap(in);
+	vector<uint16_t>().swap(niz);
+	vector<uint64_t>().swap(reci);
+	tip = INTERVALI;
+}
+
+void BitmapSkup::Kontejner::Optimizuj()
+{
+	int cenaIntervala = 4 * brojIntervala();
+	int cenaOstalih = broj <= MAKS_NIZ ? 2 * broj : 2 * BROJ_RECI * 4;
+
+	if (cenaIntervala < cenaOstalih)
+		uIntervale();
+	else if (broj <= MAKS_NIZ)
+		uNiz();
+	else
+		uBitmapu();
+}
+
+bool BitmapSkup::Kontejner::Sadrzi(uint16_t v) const
+{
+	if (tip == NIZ)
+		return binary_search(niz.begin(), niz.end(), v);
+	else if (tip == BITMAPA)
+		return (reci[v >> 6] >> (v & 63)) & 1;
+	else
+	{
+		// poslednji interval koji pocinje najkasnije u v
+		auto sledeci = std::upper_bound(intervali.begin(), intervali.end(), v, [](uint16_t x, const Interval& in) { return x < in.pocetak; });
+
+		return sledeci != intervali.begin() && v <= (sledeci - 1)->kraj;
+	}
+}
+
+bool BitmapSkup::Kontejner::Dodaj(uint16_t v)
+{
+	if (tip == NIZ)
+	{
+		auto it = std::lower_bound(niz.begin(), niz.end(), v);
+		if (it != niz.end() && *it == v)
+			return false;
+
+		niz.insert(it, v);
+		if (++broj > MAKS_NIZ)
+			uBitmapu();
+	}
+	else if (tip == BITMAPA)
+	{
+		uint64_t bit = 1ULL << (v & 63);
+		if (reci[v >> 6] & bit)
+			return false;
+
+		reci[v >> 6] |= bit;
+		broj++;
+	}
+	else
+	{
+		auto sledeci = std::upper_bound(intervali.begin(), intervali.end(), v, [](uint16_t x, const Interval& in) { return x < in.pocetak; });
+		bool spajaSeSaSledecim = sledeci != intervali.end() && sledeci->pocetak == v + 1;
+
+		if (sledeci != intervali.begin())
+		{
+			auto prethodni = sledeci - 1;
+
+			if (v <= prethodni->kraj)
+				return false;
+
+			if (v == prethodni->kraj + 1) // produzavanje prethodnog intervala
+			{
+				prethodni->kraj = v;
+
+				if (spajaSeSaSledecim) // v je spojio dva intervala
+				{
+					prethodni->kraj = sledeci->kraj;
+					intervali.erase(sledeci);
+				}
+
+				broj++;
+				return true;
+			}
+		}
+
+		if (spajaSeSaSledecim)
+			sledeci->pocetak = v;
+		else
+			intervali.insert(sledeci, Interval{ v, v });
+
+		broj++;
+		proveriIntervale();
+	}
+
+	return true;
+}
+
+bool BitmapSkup::Kontejner::Ukloni(uint16_t v)
+{
+	if (tip == NIZ)
+	{
+		auto it = std::lower_bound(niz.begin(), niz.end(), v);
+		if (it == niz.end() || *it != v)
+			return false;
+
+		niz.erase(it);
+		broj--;
+	}
+	else if (tip == BITMAPA)
+	{
+		uint64_t bit = 1ULL << (v & 63);
+		if ((reci[v >> 6] & bit) == 0)
+			return false;
+
+		reci[v >> 6] &= ~bit;
+		if (--broj < MIN_BITMAPA)
+			uNiz();
+	}
+	else
+	{
+		auto sledeci = std::upper_bound(intervali.begin(), intervali.end(), v, [](uint16_t x, const Interval& in) { return x < in.pocetak; });
+		if (sledeci == intervali.begin() || v > (sledeci - 1)->kraj)
+			return false;
+
+		auto in = sledeci - 1;
+
+		if (in->pocetak == in->kraj)
+			intervali.erase(in);
+		else if (v == in->pocetak)
+			in->pocetak++;
+		else if (v == in->kraj)
+			in->kraj--;
+		else // deljenje intervala na dva
+		{
+			Interval desni{ (uint16_t)(v + 1), in->kraj };
+			in->kraj = v - 1;
+			intervali.insert(sledeci, desni);
+		}
+
+		broj--;
+		proveriIntervale();
+	}
+
+	return true;
+}
+
+int BitmapSkup::Kontejner::UkloniOpseg(uint16_t od, uint16_t doo)
+{
+	int obrisano = 0;
+
+	if (tip == NIZ)
+	{
+		auto prvi = std::lower_bound(niz.begin(), niz.end(), od);
+		auto kraj = std::upper_bound(prvi, niz.end(), doo);
+
+		obrisano = (int)(kraj - prvi);
+		niz.erase(prvi, kraj);
+		broj -= obrisano;
+	}
+	else if (tip == BITMAPA)
+	{
+		obrisano = obrisiBitove(reci, od, doo);
+		broj -= obrisano;
+
+		if (broj < MIN_BITMAPA)
+			uNiz();
+	}
+	else
+	{
+		vector<Interval> ostali;
+		ostali.reserve(intervali.size() + 1);
+
+		for (const Interval& in : intervali)
+		{
+			if (in.kraj < od || in.pocetak > doo) // nema preklapanja
+			{
+				ostali.push_back(in);
+				continue;
+			}
+
+			obrisano += (in.kraj < doo ? in.kraj : doo) - (in.pocetak > od ? in.pocetak : od) + 1;
+
+			if (in.pocetak < od)
+				ostali.push_back(Interval{ in.pocetak, (uint16_t)(od - 1) });
+			if (in.kraj > doo)
+				ostali.push_back(Interval{ (uint16_t)(doo + 1), in.kraj });
+		}
+
+		intervali.swap(ostali);
+		broj -= obrisano;
+		proveriIntervale();
+	}
+
+	return obrisano;
+}
+
+// vrednosti su sortirane i bez ponavljanja; niz se spaja linearno, a ostali tipovi postavljaju bitove
+int BitmapSkup::Kontejner::DodajSortirane(const uint16_t * vrednosti, int koliko)
+{
+	int pre = broj;
+
+	if (tip == NIZ)
+	{
+		vector<uint16_t> spojeni;
+		spojeni.reserve(niz.size() + koliko);
+		set_union(niz.begin(), niz.end(), vrednosti, vrednosti + koliko, back_inserter(spojeni));
+
+		niz.swap(spojeni);
+		broj = (int)niz.size();
+
+		if (broj > MAKS_NIZ)
+			uBitmapu();
+	}
+	else
+	{
+		bool bileIntervali = tip == INTERVALI;
+		uBitmapu();
+
+		for (int i = 0; i < koliko; i++)
+		{
+			uint64_t bit = 1ULL << (vrednosti[i] & 63);
+			uint64_t& rec = reci[vrednosti[i] >> 6];
+
+			if ((rec & bit) == 0)
+			{
+				rec |= bit;
+				broj++;
+			}
+		}
+
+		if (bileIntervali)
+			Optimizuj();
+	}
+
+	return broj - pre;
+}
+
+int BitmapSkup::Kontejner::SledeciOd(int v) const
+{
+	if (tip == NIZ)
+	{
+		auto it = std::lower_bound(niz.begin(), niz.end(), v);
+		return it != niz.end() ? *it : -1;
+	}
+	else if (tip == BITMAPA)
+	{
+		int i = v >> 6;
+		uint64_t w = reci[i] & (~0ULL << (v & 63));
+
+		while (w == 0)
+		{
+			if (++i == BROJ_RECI)
+				return -1;
+			w = reci[i];
+		}
+
+		return i * 64 + nulaNaKraju(w);
+	}
+	else
+	{
+		// prvi interval koji se ne zavrsava pre v
+		auto it = std::lower_bound(intervali.begin(), intervali.end(), v, [](const Interval& in, int x) { return in.kraj < x; });
+		if (it == intervali.end())
+			return -1;
+
+		return it->pocetak > v ? it->pocetak : v;
+	}
+}
+
+int BitmapSkup::Kontejner::PrethodniOd(int v) const
+{
+	if (tip == NIZ)
+	{
+		auto it = std::upper_bound(niz.begin(), niz.end(), v);
+		return it != niz.begin() ? *--it : -1;
+	}
+	else if (tip == BITMAPA)
+	{
+		int i = v >> 6;
+		uint64_t w = reci[i] & (~0ULL >> (63 - (v & 63)));
+
+		while (w == 0)
+		{
+			if (--i < 0)
+				return -1;
+			w = reci[i];
+		}
+
+		return i * 64 + 63 - nulaNaPocetku(w);
+	}
+	else
+	{
+		// poslednji interval koji pocinje najkasnije u v
+		auto it = std::upper_bound(intervali.begin(), intervali.end(), v, [](int x, const Interval& in) { return x < in.pocetak; });
+		if (it == intervali.begin())
+			return -1;
+
+		--it;
+		return it->kraj < v ? it->kraj : v;
+	}
+}
+
+int BitmapSkup::Kontejner::BrojUOpsegu(int od, int doo) const
+{
+	if (tip == NIZ)
+		return (int)(std::upper_bound(niz.begin(), niz.end(), doo) - std::lower_bound(niz.begin(), niz.end(), od));
+	else if (tip == BITMAPA)
+	{
+		int prva = od >> 6, poslednja = doo >> 6;
+		uint64_t maskaPrve = ~0ULL << (od & 63);
+		uint64_t maskaPoslednje = ~0ULL >> (63 - (doo & 63));
+
+		if (prva == poslednja)
+			return brojBitova(reci[prva] & maskaPrve & maskaPoslednje);
+
+		int b = brojBitova(reci[prva] & maskaPrve) + brojBitova(reci[poslednja] & maskaPoslednje);
+		for (int i = prva + 1; i < poslednja; i++)
+			b += brojBitova(reci[i]);
+
+		return b;
+	}
+	else
+	{
+		int b = 0;
+		for (auto it = std::lower_bound(intervali.begin(), intervali.end(), od, [](const Interval& in, int x) { return in.kraj < x; });
+			it != intervali.end() && it->pocetak <= doo; ++it)
+			b += min((int)it->kraj, doo) - max((int)it->pocetak, od) + 1;
+
+		return b;
+	}
+}
+
+// reci bitmape sa istim elementima kao kontejner (za operacije rec po rec)
+void BitmapSkup::Kontejner::upisiReci(vector<uint64_t>& b) const
+{
+	b.assign(BROJ_RECI, 0);
+
+	if (tip == BITMAPA)
+		b = reci;
+	else if (tip == NIZ)
+		for (uint16_t v : niz)
+			b[v >> 6] |= 1ULL << (v & 63);
+	else
+		for (const Interval& in : intervali)
+			postaviBitove(b, in.pocetak, in.kraj);
+}
+
+// kontejner sa vrednostima iz zadatih delova (Skup::Deo) dva kontejnera sa istim kljucem
+BitmapSkup::Kontejner BitmapSkup::Kontejner::Spoji(const Kontejner & a, const Kontejner & b, int delovi)
+{
+	Kontejner r(a.kljuc);
+
+	if (a.tip == NIZ && b.tip == NIZ) // spajanje dva sortirana niza
+	{
+		size_t i = 0, j = 0;
+
+		while (i < a.niz.size() || j < b.niz.size())
+		{
+			if (j == b.niz.size() || (i < a.niz.size() && a.niz[i] < b.niz[j]))
+			{
+				if (delovi & SAMO_PRVI)
+					r.niz.push_back(a.niz[i]);
+				i++;
+			}
+			else if (i == a.niz.size() || b.niz[j] < a.niz[i])
+			{
+				if (delovi & SAMO_DRUGI)
+					r.niz.push_back(b.niz[j]);
+				j++;
+			}
+			else
+			{
+				if (delovi & OBA)
+					r.niz.push_back(a.niz[i]);
+				i++;
+				j++;
+			}
+		}
+
+		r.broj = (int)r.niz.size();
+		if (r.broj > MAKS_NIZ)
+			r.uBitmapu();
+
+		return r;
+	}
+
+	// ako rezultat ne sadrzi vrednosti samo iz jednog kontejnera, a on je niz, filtriraju se samo njegove vrednosti
+	bool filtrirajPrvi = (delovi & SAMO_DRUGI) == 0 && a.tip == NIZ;
+	bool filtrirajDrugi = (delovi & SAMO_PRVI) == 0 && b.tip == NIZ;
+
+	if (filtrirajPrvi || filtrirajDrugi)
+	{
+		const Kontejner& izvor = filtrirajPrvi ? a : b;
+		const Kontejner& ostali = filtrirajPrvi ? b : a;
+		int samoIzvor = filtrirajPrvi ? SAMO_PRVI : SAMO_DRUGI;
+
+		for (uint16_t v : izvor.niz)
+			if (delovi & (ostali.Sadrzi(v) ? OBA : samoIzvor))
+				r.niz.push_back(v);
+
+		r.broj = (int)r.niz.size();
+		return r;
+	}
+
+	// u ostalim slucajevima rezultat se racuna rec po rec nad bitmapama
+	vector<uint64_t> x, y;
+	a.upisiReci(x);
+	b.upisiReci(y);
+
+	r.reci.resize(BROJ_RECI);
+	r.tip = BITMAPA;
+
+	for (int i = 0; i < BROJ_RECI; i++)
+	{
+		uint64_t w = 0;
+
+		if (delovi & SAMO_PRVI)
+			w |= x[i] & ~y[i];
+		if (delovi & OBA)
+			w |= x[i] & y[i];
+		if (delovi & SAMO_DRUGI)
+			w |= ~x[i] & y[i];
+
+		r.reci[i] = w;
+		r.broj += brojBitova(w);
+	}
+
+	if (a.tip == INTERVALI || b.tip == INTERVALI)
+		r.Optimizuj();
+	else if (r.broj <= MAKS_NIZ)
+		r.uNiz();
+
+	return r;
+}
+
+// velicina preseka dva kontejnera sa istim kljucem - ostali delovi se dobijaju oduzimanjem od broja elemenata
+int BitmapSkup::Kontejner::BrojZajednickih(const Kontejner & a, const Kontejner & b)
+{
+	int zajednickih = 0;
+
+	if (a.tip == NIZ || b.tip == NIZ)
+	{
+		const Kontejner& manji = a.tip == NIZ ? a : b;
+		const Kontejner& ostali = a.tip == NIZ ? b : a;
+
+		for (uint16_t v : manji.niz)
+			if (ostali.Sadrzi(v))
+				zajednickih++;
+	}
+	else
+	{
+		vector<uint64_t> x, y;
+		a.upisiReci(x);
+		b.upisiReci(y);
+
+		for (int i = 0; i < BROJ_RECI; i++)
+			zajednickih += brojBitova(x[i] & y[i]);
+	}
+
+	return zajednickih;
+}
+
+int BitmapSkup::pronadiKontejner(uint16_t kljuc) const
+{
+	auto it = std::lower_bound(kontejneri.begin(), kontejneri.end(), kljuc, [](const Kontejner& c, uint16_t k) { return c.kljuc < k; });
+
+	return (int)(it - kontejneri.begin());
+}
+
+void BitmapSkup::pisi(ostream & o) const
+{
+	for (const Kontejner& c : kontejneri)
+	{
+		uint32_t gornji = (uint32_t)c.kljuc << 16;
+		c.ZaSvaki([&o, gornji](uint16_t v) { o << uOznacen(gornji | v) << ' '; });
+	}
+}
+
+bool BitmapSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	uint32_t u = uNeoznacen(k);
+	int i = pronadiKontejner(u >> 16);
+	BROJI_POSETU(Instrumentacija::BrojKoraka(kontejneri.size()));
+
+	return i < (int)kontejneri.size() && kontejneri[i].kljuc == (u >> 16) && kontejneri[i].Sadrzi(u & 0xFFFF);
+}
+
+// upit je vec O(log broja kontejnera), pa serija samo izbegava virtuelni poziv po kljucu
+void BitmapSkup::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	for (size_t i = 0; i < broj; i++)
+		rezultat[i] = BitmapSkup::PostojanjeElementa(kljucevi[i]);
+}
+
+BitmapSkup & BitmapSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	uint32_t u = uNeoznacen(k);
+	int i = pronadiKontejner(u >> 16);
+
+	if (i == (int)kontejneri.size() || kontejneri[i].kljuc != (u >> 16))
+		kontejneri.insert(kontejneri.begin() + i, Kontejner(u >> 16));
+
+	if (kontejneri[i].Dodaj(u & 0xFFFF))
+		n++;
+
+	return *this;
+}
+
+/* serija se sortira (poredak oznacenih kljuceva je isti kao poredak preslikanih) i deli po
+gornjih 16 bitova, a kontejneri se spajaju sa postojecim jednim prolazom - O(n + k) */
+BitmapSkup & BitmapSkup::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	if (broj <= 0)
+		return *this;
+
+	vector<int> kljucevi(niz, niz + broj);
+	pripremiSeriju(kljucevi);
+
+	vector<Kontejner> novi;
+	novi.reserve(kontejneri.size() + 1);
+
+	vector<uint16_t> donji;
+	size_t i = 0, j = 0;
+
+	while (j < kljucevi.size())
+	{
+		uint16_t kljuc = uNeoznacen(kljucevi[j]) >> 16;
+
+		donji.clear();
+		for (; j < kljucevi.size() && (uNeoznacen(kljucevi[j]) >> 16) == kljuc; j++)
+			donji.push_back(uNeoznacen(kljucevi[j]) & 0xFFFF);
+
+		while (i < kontejneri.size() && kontejneri[i].kljuc < kljuc)
+			novi.push_back(move(kontejneri[i++]));
+
+		if (i < kontejneri.size() && kontejneri[i].kljuc == kljuc)
+			novi.push_back(move(kontejneri[i++]));
+		else
+			novi.push_back(Kontejner(kljuc));
+
+		n += novi.back().DodajSortirane(donji.data(), (int)donji.size());
+	}
+
+	while (i < kontejneri.size())
+		novi.push_back(move(kontejneri[i++]));
+
+	kontejneri.swap(novi);
+
+	return *this;
+}
+
+BitmapSkup & BitmapSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	uint32_t u = uNeoznacen(k);
+	int i = pronadiKontejner(u >> 16);
+
+	if (i < (int)kontejneri.size() && kontejneri[i].kljuc == (u >> 16) && kontejneri[i].Ukloni(u & 0xFFFF))
+	{
+		n--;
+
+		if (kontejneri[i].broj == 0)
+			kontejneri.erase(kontejneri.begin() + i);
+	}
+
+	return *this;
+}
+
+BitmapSkup & BitmapSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	uint32_t od = uNeoznacen(min), doo = uNeoznacen(max);
+	uint16_t prviKljuc = od >> 16, poslednjiKljuc = doo >> 16;
+
+	int prvi = pronadiKontejner(prviKljuc), i;
+
+	for (i = prvi; i < (int)kontejneri.size() && kontejneri[i].kljuc <= poslednjiKljuc; i++)
+	{
+		Kontejner& c = kontejneri[i];
+		uint16_t dole = c.kljuc == prviKljuc ? (od & 0xFFFF) : 0;
+		uint16_t gore = c.kljuc == poslednjiKljuc ? (doo & 0xFFFF) : 0xFFFF;
+
+		if (dole == 0 && gore == 0xFFFF) // ceo kontejner je u opsegu i izbacuje se bez obilaska
+		{
+			n -= c.broj;
+			c.broj = 0;
+		}
+		else
+			n -= c.UkloniOpseg(dole, gore);
+	}
+
+	kontejneri.erase(remove_if(kontejneri.begin() + prvi, kontejneri.begin() + i, [](const Kontejner& c) { return c.broj == 0; }), kontejneri.begin() + i);
+
+	return *this;
+}
+
+void BitmapSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	vector<Kontejner>().swap(kontejneri);
+	n = 0;
+}
+
+BitmapSkup * BitmapSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+// menjaju se samo kontejneri sa kljucem koji postoji i u drugom skupu; ostali se ne diraju
+BitmapSkup & BitmapSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	const BitmapSkup* drugi = dynamic_cast<const BitmapSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+	{
+		razlikaUMestuKursorima(s2);
+		return *this;
+	}
+
+	if (drugi == this)
+	{
+		IsprazniSkup();
+		return *this;
+	}
+
+	const vector<Kontejner>& b = drugi->kontejneri;
+	size_t i = 0, j = 0;
+	bool ispraznjen = false;
+
+	while (i < kontejneri.size() && j < b.size())
+	{
+		if (kontejneri[i].kljuc < b[j].kljuc)
+			i++;
+		else if (kontejneri[i].kljuc > b[j].kljuc)
+			j++;
+		else
+		{
+			Kontejner& a = kontejneri[i];
+			n -= a.broj;
+			a = Kontejner::Spoji(a, b[j], SAMO_PRVI);
+			n += a.broj;
+
+			ispraznjen = ispraznjen || a.broj == 0;
+			i++;
+			j++;
+		}
+	}
+
+	if (ispraznjen)
+		kontejneri.erase(remove_if(kontejneri.begin(), kontejneri.end(), [](const Kontejner& c) { return c.broj == 0; }), kontejneri.end());
+
+	return *this;
+}
+
+// spajanje po kljucevima kontejnera - operacija se racuna samo za kontejnere sa istim kljucem
+BitmapSkup * BitmapSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	const BitmapSkup* drugi = dynamic_cast<const BitmapSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<BitmapSkup*>(spojiKursorima(s2, delovi));
+
+	const vector<Kontejner>& a = kontejneri;
+	const vector<Kontejner>& b = drugi->kontejneri;
+
+	BitmapSkup* rezultat = new BitmapSkup();
+	size_t i = 0, j = 0;
+
+	while (i < a.size() || j < b.size())
+	{
+		if (j == b.size() || (i < a.size() && a[i].kljuc < b[j].kljuc))
+		{
+			if (delovi & SAMO_PRVI)
+			{
+				rezultat->kontejneri.push_back(a[i]);
+				rezultat->n += a[i].broj;
+			}
+			i++;
+		}
+		else if (i == a.size() || b[j].kljuc < a[i].kljuc)
+		{
+			if (delovi & SAMO_DRUGI)
+			{
+				rezultat->kontejneri.push_back(b[j]);
+				rezultat->n += b[j].broj;
+			}
+			j++;
+		}
+		else
+		{
+			Kontejner r = Kontejner::Spoji(a[i], b[j], delovi);
+			if (r.broj > 0)
+			{
+				rezultat->n += r.broj;
+				rezultat->kontejneri.push_back(move(r));
+			}
+
+			i++;
+			j++;
+		}
+	}
+
+	return rezultat;
+}
+
+// kontejneri nikad nisu prazni, pa kontejner bez para odmah odlucuje ishod
+bool BitmapSkup::postoji(const Skup & s2, int delovi) const
+{
+	const BitmapSkup* drugi = dynamic_cast<const BitmapSkup*>(&s2);
+	if (drugi == nullptr) // druga vrsta skupa - spajanje preko kursora
+		return postojiKursorima(s2, delovi);
+
+	const vector<Kontejner>& a = kontejneri;
+	const vector<Kontejner>& b = drugi->kontejneri;
+	size_t i = 0, j = 0;
+
+	while (i < a.size() || j < b.size())
+	{
+		if (j == b.size() || (i < a.size() && a[i].kljuc < b[j].kljuc))
+		{
+			if (delovi & SAMO_PRVI)
+				return true;
+			i++;
+		}
+		else if (i == a.size() || b[j].kljuc < a[i].kljuc)
+		{
+			if (delovi & SAMO_DRUGI)
+				return true;
+			j++;
+		}
+		else
+		{
+			int zajednickih = Kontejner::BrojZajednickih(a[i], b[j]);
+
+			if (((delovi & OBA) && zajednickih > 0) || ((delovi & SAMO_PRVI) && a[i].broj > zajednickih) || ((delovi & SAMO_DRUGI) && b[j].broj > zajednickih))
+				return true;
+
+			i++;
+			j++;
+		}
+	}
+
+	return false;
+}
+
+void BitmapSkup::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<BitmapSkup*>(s));
+	delete s;
+}
+
+BitmapSkup & BitmapSkup::Optimizuj()
+{
+	for (Kontejner& c : kontejneri)
+		c.Optimizuj();
+
+	return *this;
+}
+
+
+BitmapSkup * BitmapSkup::prazan() const
+{
+	return new BitmapSkup();
+}
+
+unique_ptr<Skup::Kursor> BitmapSkup::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new Kursor(kontejneri));
+}
+
+// pozicija je (indeks kontejnera << 16) | donjih 16 bitova kljuca, a kraj (broj kontejnera << 16)
+uintptr_t BitmapSkup::pozicijaNeManjegOd(int k) const
+{
+	Kursor kursor(kontejneri);
+	kursor.Trazi(k);
+
+	return kursor.Vazeci() ? kursor.Pozicija() : pozicijaKraja();
+}
+
+uintptr_t BitmapSkup::pozicijaKraja() const
+{
+	return (uintptr_t)kontejneri.size() << 16;
+}
+
+uintptr_t BitmapSkup::sledecaPozicija(uintptr_t p) const
+{
+	size_t i = p >> 16;
+	int v = p & 0xFFFF;
+
+	v = v < 0xFFFF ? kontejneri[i].SledeciOd(v + 1) : -1;
+	if (v >= 0)
+		return (uintptr_t)i << 16 | v;
+
+	// kontejneri nikad nisu prazni
+	return ++i < kontejneri.size() ? (uintptr_t)i << 16 | kontejneri[i].SledeciOd(0) : pozicijaKraja();
+}
+
+uintptr_t BitmapSkup::prethodnaPozicija(uintptr_t p) const
+{
+	size_t i = p >> 16;
+	int v = p & 0xFFFF;
+
+	v = i < kontejneri.size() && v > 0 ? kontejneri[i].PrethodniOd(v - 1) : -1;
+	if (v >= 0)
+		return (uintptr_t)i << 16 | v;
+
+	i--;
+	return (uintptr_t)i << 16 | kontejneri[i].PrethodniOd(0xFFFF);
+}
+
+int BitmapSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return uOznacen((uint32_t)kontejneri[p >> 16].kljuc << 16 | (uint32_t)(p & 0xFFFF));
+}
+
+// unutrasnji kontejneri opsega se broje cele, a samo krajnji po vrednostima
+int BitmapSkup::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (min > max)
+		throw INDEKS;
+
+	uint32_t od = uNeoznacen(min), doo = uNeoznacen(max);
+	uint16_t gornjiOd = od >> 16, gornjiDo = doo >> 16;
+
+	auto it = std::lower_bound(kontejneri.begin(), kontejneri.end(), gornjiOd, [](const Kontejner& c, uint16_t g) { return c.kljuc < g; });
+
+	int broj = 0;
+	for (; it != kontejneri.end() && it->kljuc <= gornjiDo; ++it)
+	{
+		int donjiOd = it->kljuc == gornjiOd ? od & 0xFFFF : 0;
+		int donjiDo = it->kljuc == gornjiDo ? doo & 0xFFFF : 0xFFFF;
+
+		broj += donjiOd == 0 && donjiDo == 0xFFFF ? it->broj : it->BrojUOpsegu(donjiOd, donjiDo);
+	}
+
+	return broj;
+}
+
+// kontejneri nikad nisu prazni, pa posle poslednje vrednosti jednog sledi prva vrednost narednog
+void BitmapSkup::Kursor::Sledeci()
+{
+	v = v < 0xFFFF ? kontejneri[i].SledeciOd(v + 1) : -1;
+
+	if (v < 0)
+	{
+		i++;
+		naPrvi();
+	}
+}
+
+void BitmapSkup::Kursor::Trazi(int k)
+{
+	uint32_t u = uNeoznacen(k);
+	uint16_t gornji = u >> 16;
+	int donji = u & 0xFFFF;
+
+	if (!Vazeci() || kontejneri[i].kljuc > gornji || (kontejneri[i].kljuc == gornji && v >= donji))
+		return;
+
+	if (kontejneri[i].kljuc < gornji)
+	{
+		i = std::lower_bound(kontejneri.begin() + i, kontejneri.end(), gornji, [](const Kontejner& c, uint16_t g) { return c.kljuc < g; }) - kontejneri.begin();
+
+		if (i == kontejneri.size() || kontejneri[i].kljuc > gornji)
+		{
+			naPrvi();
+			return;
+		}
+	}
+
+	v = kontejneri[i].SledeciOd(donji);
+
+	if (v < 0)
+	{
+		i++;
+		naPrvi();
+	}
+}
+
+#pragma endregion
+
+#pragma region "KonkurentniSkup.cpp"
+
+void KonkurentniSkup::inicijalizuj()
+{
+	glava = new Cvor(0, MAKS_NIVO);
+	glava->povezan = true;
+	n = 0;
+
+	for (Traka& t : trake)
+		t.prijavljenih[0] = t.prijavljenih[1] = 0;
+	epoha = 0;
+	povuceni[0] = povuceni[1] = nullptr;
+	doCiscenja = 0;
+}
+
+// kopiranje u jednom prolazu - novi cvorovi se kace na kraj svakog svog nivoa
+void KonkurentniSkup::kopiraj(const KonkurentniSkup & s)
+{
+	Cvor* poslednji[MAKS_NIVO];
+	for (int l = 0; l < MAKS_NIVO; l++)
+		poslednji[l] = glava;
+
+	Zastita z(s);
+	int broj = 0;
+	for (const Cvor* p = s.neManjiOd(INT_MIN); p != nullptr; p = s.sledeciVazeci(p))
+	{
+		Cvor* novi = new Cvor(p->kljuc, slucajanNivo());
+		novi->povezan = true;
+
+		for (int l = 0; l < novi->nivo; l++)
+		{
+			poslednji[l]->sledeci[l].store(novi, memory_order_relaxed);
+			poslednji[l] = novi;
+		}
+
+		broj++;
+	}
+
+	n = broj;
+}
+
+void KonkurentniSkup::premesti(KonkurentniSkup & s)
+{
+	swap(glava, s.glava);
+
+	int broj = n;
+	n = s.n.load();
+	s.n = broj;
+
+	// izvezeni cvorovi idu zajedno sa epohom u kojoj su izvezeni
+	for (int i = 0; i < 2; i++)
+		povuceni[i] = s.povuceni[i].exchange(povuceni[i]);
+	epoha = s.epoha.exchange(epoha);
+}
+
+void KonkurentniSkup::obrisi()
+{
+	OslobodiPovucene();
+
+	Cvor* p = glava->sledeci[0];
+	while (p != nullptr)
+	{
+		Cvor* sledeci = p->sledeci[0];
+		delete p;
+		p = sledeci;
+	}
+
+	for (int l = 0; l < MAKS_NIVO; l++)
+		glava->sledeci[l] = nullptr;
+
+	n = 0;
+}
+
+KonkurentniSkup::~KonkurentniSkup()
+{
+	obrisi();
+	delete glava;
+}
+
+// svaka nit ima svoj generator, pa izbor nivoa ne zahteva sinhronizaciju
+int KonkurentniSkup::slucajanNivo()
+{
+	static thread_local uint32_t stanje = (2463534242u ^ (uint32_t)hash<thread::id>()(this_thread::get_id())) | 1;
+
+	stanje ^= stanje << 13;
+	stanje ^= stanje >> 17;
+	stanje ^= stanje << 5;
+
+	// nivo raste sa verovatnocom 1/4, kao u indeksu DCLLSkup
+	int nivo = 1;
+	for (uint32_t r = stanje; (r & 3) == 0 && nivo < MAKS_NIVO; r >>= 2)
+		nivo++;
+
+	return nivo;
+}
+
+/* prethodnici i sledbenici kljuca k na svim nivoima, bez zakljucavanja; vraca najvisi nivo
+na kome je k nadjen, ili -1 */
+int KonkurentniSkup::pronadji(int k, Cvor ** prethodnici, Cvor ** sledbenici) const
+{
+	int nadjen = -1;
+	Cvor* prethodni = glava;
+
+	for (int l = MAKS_NIVO - 1; l >= 0; l--)
+	{
+		Cvor* tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+		while (tekuci != nullptr && tekuci->kljuc < k)
+		{
+			prethodni = tekuci;
+			tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+			BROJI_POSETU(1);
+		}
+
+		if (nadjen == -1 && tekuci != nullptr && tekuci->kljuc == k)
+			nadjen = l;
+
+		prethodnici[l] = prethodni;
+		sledbenici[l] = tekuci;
+	}
+
+	return nadjen;
+}
+
+// isti prethodnik moze biti na vise uzastopnih nivoa, a zakljucan je samo jednom
+void KonkurentniSkup::otkljucaj(Cvor ** prethodnici, int doNivoa)
+{
+	for (int l = 0; l <= doNivoa; l++)
+		if (l == 0 || prethodnici[l] != prethodnici[l - 1])
+			prethodnici[l]->brava.unlock();
+}
+
+// svaka nit uvek koristi istu traku
+int KonkurentniSkup::traka()
+{
+	static thread_local int t = (int)(hash<thread::id>()(this_thread::get_id()) % TRAKA);
+
+	return t;
+}
+
+/* operacija se prijavljuje u epohi koju je procitala, pa proverava da se epoha u medjuvremenu
+nije pomerila - inace bi nit koja pomera epohu mogla da je ne vidi */
+KonkurentniSkup::Zastita::Zastita(const KonkurentniSkup & skup)
+{
+	Traka& t = skup.trake[traka()];
+
+	while (true)
+	{
+		uint64_t e = skup.epoha.load();
+		brojac = &t.prijavljenih[e & 1];
+		brojac->fetch_add(1);
+
+		if (skup.epoha.load() == e)
+			return;
+
+		brojac->fetch_sub(1, memory_order_release);
+	}
+}
+
+/* izvezen cvor ide u listu epohe u kojoj je izvezen, jer ga neka nit mozda jos cita;
+epoha se cita tek posle izvozenja, pa operacije prijavljene kasnije ne mogu doci do cvora */
+void KonkurentniSkup::povuci(Cvor * p)
+{
+	atomic<Cvor*>& lista = povuceni[epoha.load() & 1];
+
+	p->sledeciPovucen = lista.load(memory_order_relaxed);
+	while (!lista.compare_exchange_weak(p->sledeciPovucen, p, memory_order_release, memory_order_relaxed));
+
+	if (doCiscenja.fetch_add(1, memory_order_relaxed) + 1 >= PRAG_CISCENJA)
+	{
+		doCiscenja.store(0, memory_order_relaxed);
+		pomeriEpohu();
+	}
+}
+
+/* epoha ide sa e na e + 1 kada nema prijavljenih u e - 1; tada su i cvorovi izvezeni u e - 1
+nedostupni svima, pa se oslobadjaju. Njihova lista se preuzima pre pomeranja, jer je posle
+pomeranja koristi epoha e + 1 iste parnosti */
+void KonkurentniSkup::pomeriEpohu()
+{
+	unique_lock<mutex> l(ciscenje, try_to_lock);
+	if (!l.owns_lock())
+		return;
+
+	uint64_t e = epoha.load();
+	int stara = (int)((e + 1) & 1);
+
+	for (const Traka& t : trake)
+		if (t.prijavljenih[stara].load() != 0)
+			return;
+
+	Cvor* p = povuceni[stara].exchange(nullptr, memory_order_acquire);
+	epoha.store(e + 1);
+	l.unlock();
+
+	oslobodi(p);
+}
+
+void KonkurentniSkup::oslobodi(Cvor * p)
+{
+	while (p != nullptr)
+	{
+		Cvor* sledeci = p->sledeciPovucen;
+		delete p;
+		p = sledeci;
+	}
+}
+
+void KonkurentniSkup::OslobodiPovucene()
+{
+	for (atomic<Cvor*>& lista : povuceni)
+		oslobodi(lista.exchange(nullptr));
+}
+
+// cvorovi koji jos nisu povezani ili su oznaceni za brisanje nisu u skupu i preskacu se
+const KonkurentniSkup::Cvor * KonkurentniSkup::sledeciVazeci(const Cvor * p) const
+{
+	do
+		p = p->sledeci[0].load(memory_order_acquire);
+	while (p != nullptr && !p->Vazeci());
+
+	return p;
+}
+
+const KonkurentniSkup::Cvor * KonkurentniSkup::neManjiOd(int k) const
+{
+	const Cvor* prethodni = glava;
+
+	for (int l = MAKS_NIVO - 1; l >= 0; l--)
+	{
+		const Cvor* tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+		while (tekuci != nullptr && tekuci->kljuc < k)
+		{
+			prethodni = tekuci;
+			tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+			BROJI_POSETU(1);
+		}
+	}
+
+	return sledeciVazeci(prethodni);
+}
+
+// najveci kljuc manji od k (ili najveci uopste ako je bezGranice), nullptr ako ga nema
+const KonkurentniSkup::Cvor * KonkurentniSkup::poslednjiManjiOd(int k, bool bezGranice) const
+{
+	while (true)
+	{
+		const Cvor* prethodni = glava;
+
+		for (int l = MAKS_NIVO - 1; l >= 0; l--)
+		{
+			const Cvor* tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+			while (tekuci != nullptr && (bezGranice || tekuci->kljuc < k))
+			{
+				prethodni = tekuci;
+				tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+			}
+		}
+
+		if (prethodni == glava)
+			return nullptr;
+		if (prethodni->Vazeci())
+			return prethodni;
+
+		// nadjeni cvor je upravo izbacen - trazi se prethodni pre njega
+		k = prethodni->kljuc;
+		bezGranice = false;
+	}
+}
+
+void KonkurentniSkup::pisi(ostream & o) const
+{
+	Zastita z(*this);
+	for (const Cvor* p = neManjiOd(INT_MIN); p != nullptr; p = sledeciVazeci(p))
+		o << p->kljuc << ' ';
+}
+
+KonkurentniSkup & KonkurentniSkup::operator=(const KonkurentniSkup & s)
+{
+	if (this != &s) { obrisi(); kopiraj(s); }
+
+	return *this;
+}
+
+KonkurentniSkup & KonkurentniSkup::operator=(KonkurentniSkup && s)
+{
+	if (this != &s) { obrisi(); premesti(s); }
+
+	return *this;
+}
+
+// bez zakljucavanja i bez ponavljanja - jedan spust kroz nivoe
+bool KonkurentniSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	Zastita z(*this);
+	const Cvor* prethodni = glava;
+
+	for (int l = MAKS_NIVO - 1; l >= 0; l--)
+	{
+		const Cvor* tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+		while (tekuci != nullptr && tekuci->kljuc < k)
+		{
+			prethodni = tekuci;
+			tekuci = prethodni->sledeci[l].load(memory_order_acquire);
+			BROJI_POSETU(1);
+		}
+
+		if (tekuci != nullptr && tekuci->kljuc == k)
+			return tekuci->Vazeci();
+	}
+
+	return false;
+}
+
+/* prethodnici se zakljucavaju odozdo nagore i proverava se da su i dalje u skupu i da
+pokazuju na iste sledbenike; ako nisu, neka druga nit je u medjuvremenu izmenila okolinu
+kljuca i pokusaj se ponavlja */
+KonkurentniSkup & KonkurentniSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	Zastita z(*this);
+	Cvor* prethodnici[MAKS_NIVO];
+	Cvor* sledbenici[MAKS_NIVO];
+	int nivo = slucajanNivo();
+
+	while (true)
+	{
+		int nadjen = pronadji(k, prethodnici, sledbenici);
+		if (nadjen != -1)
+		{
+			Cvor* p = sledbenici[nadjen];
+			if (!p->oznacen.load(memory_order_acquire))
+			{
+				// kljuc je vec u skupu ili ce biti cim ga druga nit poveze
+				while (!p->povezan.load(memory_order_acquire))
+					this_thread::yield();
+
+				return *this;
+			}
+
+			continue; // kljuc se upravo brise - ponovo, kada bude izvezen
+		}
+
+		int zakljucano = -1;
+		bool ispravno = true;
+
+		for (int l = 0; ispravno && l < nivo; l++)
+		{
+			Cvor* prethodni = prethodnici[l];
+			Cvor* sledbenik = sledbenici[l];
+
+			if (l == 0 || prethodni != prethodnici[l - 1])
+				prethodni->brava.lock();
+			zakljucano = l;
+
+			ispravno = !prethodni->oznacen.load(memory_order_acquire)
+				&& (sledbenik == nullptr || !sledbenik->oznacen.load(memory_order_acquire))
+				&& prethodni->sledeci[l].load(memory_order_acquire) == sledbenik;
+		}
+
+		if (!ispravno)
+		{
+			otkljucaj(prethodnici, zakljucano);
+			continue;
+		}
+
+		Cvor* novi = new Cvor(k, nivo);
+		BROJI_ALOKACIJU();
+		for (int l = 0; l < nivo; l++)
+			novi->sledeci[l].store(sledbenici[l], memory_order_relaxed);
+		for (int l = 0; l < nivo; l++)
+			prethodnici[l]->sledeci[l].store(novi, memory_order_release);
+
+		novi->povezan.store(true, memory_order_release);
+		n.fetch_add(1, memory_order_relaxed);
+
+		otkljucaj(prethodnici, zakljucano);
+		return *this;
+	}
+}
+
+/* brisanje se izvodi nad cvorom koji je potpuno povezan i nadjen na svom najvisem nivou:
+oznacavanje pod bravom cvora je tacka u kojoj kljuc napusta skup, a izvozenje sa svih nivoa
+se radi pod bravama prethodnika */
+KonkurentniSkup & KonkurentniSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	Zastita z(*this);
+	Cvor* prethodnici[MAKS_NIVO];
+	Cvor* sledbenici[MAKS_NIVO];
+	Cvor* zrtva = nullptr;
+	bool oznacen = false;
+
+	while (true)
+	{
+		int nadjen = pronadji(k, prethodnici, sledbenici);
+
+		if (!oznacen)
+		{
+			if (nadjen == -1)
+				return *this;
+
+			zrtva = sledbenici[nadjen];
+			if (!zrtva->povezan.load(memory_order_acquire) || zrtva->nivo - 1 != nadjen || zrtva->oznacen.load(memory_order_acquire))
+				return *this;
+
+			zrtva->brava.lock();
+			if (zrtva->oznacen.load(memory_order_relaxed)) // druga nit je stigla pre
+			{
+				zrtva->brava.unlock();
+				return *this;
+			}
+
+			zrtva->oznacen.store(true, memory_order_release);
+			oznacen = true;
+		}
+
+		int zakljucano = -1;
+		bool ispravno = true;
+
+		for (int l = 0; ispravno && l < zrtva->nivo; l++)
+		{
+			Cvor* prethodni = prethodnici[l];
+
+			if (l == 0 || prethodni != prethodnici[l - 1])
+				prethodni->brava.lock();
+			zakljucano = l;
+
+			ispravno = !prethodni->oznacen.load(memory_order_acquire) && prethodni->sledeci[l].load(memory_order_acquire) == zrtva;
+		}
+
+		if (!ispravno)
+		{
+			otkljucaj(prethodnici, zakljucano);
+			continue;
+		}
+
+		for (int l = zrtva->nivo - 1; l >= 0; l--)
+			prethodnici[l]->sledeci[l].store(zrtva->sledeci[l].load(memory_order_relaxed), memory_order_release);
+
+		n.fetch_sub(1, memory_order_relaxed);
+
+		zrtva->brava.unlock();
+		otkljucaj(prethodnici, zakljucano);
+
+		povuci(zrtva);
+		return *this;
+	}
+}
+
+KonkurentniSkup & KonkurentniSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	vector<int> kljucevi;
+	{
+		Zastita z(*this);
+		for (const Cvor* p = neManjiOd(min); p != nullptr && p->kljuc <= max; p = sledeciVazeci(p))
+			kljucevi.push_back(p->kljuc);
+	}
+
+	for (int k : kljucevi)
+		ObrisiElement(k);
+
+	return *this;
+}
+
+void KonkurentniSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	obrisi();
+}
+
+KonkurentniSkup * KonkurentniSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+// operacije nad celim skupovima idu preko kursora, i za dva konkurentna skupa
+KonkurentniSkup & KonkurentniSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	if (&s2 == this)
+	{
+		obrisi();
+		return *this;
+	}
+
+	razlikaUMestuKursorima(s2);
+	return *this;
+}
+
+KonkurentniSkup * KonkurentniSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	return static_cast<KonkurentniSkup*>(spojiKursorima(s2, delovi));
+}
+
+bool KonkurentniSkup::postoji(const Skup & s2, int delovi) const
+{
+	return postojiKursorima(s2, delovi);
+}
+
+void KonkurentniSkup::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<KonkurentniSkup*>(s));
+	delete s;
+}
+
+KonkurentniSkup * KonkurentniSkup::prazan() const
+{
+	return new KonkurentniSkup();
+}
+
+unique_ptr<Skup::Kursor> KonkurentniSkup::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new Kursor(this));
+}
+
+/* pozicija je kljuc u donjih 32 bita sa postavljenim bitom 32 (kao kod MapiraniSkup), a kraj 0:
+iterator izmedju dva koraka ne drzi cvor, pa cvor moze biti oslobodjen, a korak se pravi novim
+spustom od kljuca - O(log n) umesto O(1) po koraku */
+uintptr_t KonkurentniSkup::pozicijaNeManjegOd(int k) const
+{
+	Zastita z(*this);
+	const Cvor* p = neManjiOd(k);
+
+	return p == nullptr ? 0 : (uintptr_t)1 << 32 | (uint32_t)p->kljuc;
+}
+
+uintptr_t KonkurentniSkup::pozicijaKraja() const
+{
+	return 0;
+}
+
+uintptr_t KonkurentniSkup::sledecaPozicija(uintptr_t p) const
+{
+	int k = kljucNaPoziciji(p);
+
+	return k == INT_MAX ? 0 : pozicijaNeManjegOd(k + 1);
+}
+
+uintptr_t KonkurentniSkup::prethodnaPozicija(uintptr_t p) const
+{
+	Zastita z(*this);
+	const Cvor* c = p == 0 ? poslednjiManjiOd(0, true) : poslednjiManjiOd(kljucNaPoziciji(p), false);
+
+	return c == nullptr ? 0 : (uintptr_t)1 << 32 | (uint32_t)c->kljuc;
+}
+
+int KonkurentniSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return (int)(uint32_t)p;
+}
+
+#pragma endregion
+
+#pragma region "ParticionisaniSkup.cpp"
+
+void ParticionisaniSkup::napravi(int _vrsta, int brojParticija)
+{
+	if (brojParticija < 1 || brojParticija > 1024)
+		throw INDEKS;
+	if (_vrsta == FabrikaSkupova::PARTICIONISANI)
+		throw TIP;
+
+	vrsta = _vrsta;
+	particije.clear();
+
+	for (int i = 0; i < brojParticija; i++)
+	{
+		Skup* s = FabrikaSkupova::Napravi(vrsta);
+		if (s == nullptr)
+			throw TIP;
+
+		particije.emplace_back(new Particija(s));
+	}
+}
+
+// kopija particije je unija praznog skupa iste vrste sa njom
+void ParticionisaniSkup::kopiraj(const ParticionisaniSkup & s)
+{
+	napravi(s.vrsta, (int)s.particije.size());
+
+	for (size_t i = 0; i < particije.size(); i++)
+	{
+		*particije[i]->skup |= *s.particije[i]->skup;
+		particije[i]->broj = particije[i]->skup->BrojElemenata();
+	}
+}
+
+ParticionisaniSkup & ParticionisaniSkup::operator=(const ParticionisaniSkup & s)
+{
+	if (this != &s)
+		kopiraj(s);
+
+	return *this;
+}
+
+ParticionisaniSkup & ParticionisaniSkup::operator=(ParticionisaniSkup && s)
+{
+	if (this != &s)
+	{
+		IsprazniSkup();
+		swap(vrsta, s.vrsta);
+		particije.swap(s.particije);
+	}
+
+	return *this;
+}
+
+int ParticionisaniSkup::najmanjiU(size_t i) const
+{
+	// najmanje u za koje je u * broj / 2^32 >= i
+	uint64_t u = (((uint64_t)i << 32) + particije.size() - 1) / particije.size();
+	return uOznacen((uint32_t)u);
+}
+
+void ParticionisaniSkup::pisi(ostream & o) const
+{
+	for (const unique_ptr<Particija>& p : particije)
+		o << *p->skup;
+}
+
+bool ParticionisaniSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	Particija& p = *particije[particijaZa(k)];
+
+	lock_guard<mutex> l(p.brava);
+	return p.skup->PostojanjeElementa(k);
+}
+
+// upiti se dele po particijama, pa se svaka zakljucava jednom za ceo svoj deo serije
+void ParticionisaniSkup::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	vector<vector<int>> delovi(particije.size());
+	vector<vector<size_t>> mesta(particije.size());
+	for (size_t i = 0; i < broj; i++)
+	{
+		size_t d = particijaZa(kljucevi[i]);
+		delovi[d].push_back(kljucevi[i]);
+		mesta[d].push_back(i);
+	}
+
+	unique_ptr<bool[]> deo(new bool[broj]);
+	for (size_t d = 0; d < particije.size(); d++)
+	{
+		if (delovi[d].empty())
+			continue;
+
+		{
+			lock_guard<mutex> l(particije[d]->brava);
+			particije[d]->skup->PostojanjeElemenata(delovi[d].data(), delovi[d].size(), deo.get());
+		}
+
+		for (size_t i = 0; i < mesta[d].size(); i++)
+			rezultat[mesta[d][i]] = deo[i];
+	}
+}
+
+ParticionisaniSkup & ParticionisaniSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	Particija& p = *particije[particijaZa(k)];
+
+	lock_guard<mutex> l(p.brava);
+	p.skup->UmetniElement(k);
+	p.broj.store(p.skup->BrojElemenata(), memory_order_relaxed);
+
+	return *this;
+}
+
+// serija se deli po particijama, a particije se pune paralelno
+ParticionisaniSkup & ParticionisaniSkup::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	vector<vector<int>> delovi(particije.size());
+	for (int i = 0; i < broj; i++)
+		delovi[particijaZa(niz[i])].push_back(niz[i]);
+
+	auto umetni = [&](int i)
+	{
+		if (delovi[i].empty())
+			return;
+
+		Particija& p = *particije[i];
+		lock_guard<mutex> l(p.brava);
+		p.skup->UmetniElemente(delovi[i].data(), (int)delovi[i].size());
+		p.broj.store(p.skup->BrojElemenata(), memory_order_relaxed);
+	};
+
+	BazenNiti::Zajednicki().Izvrsi((int)particije.size(), umetni);
+
+	return *this;
+}
+
+ParticionisaniSkup & ParticionisaniSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	Particija& p = *particije[particijaZa(k)];
+
+	lock_guard<mutex> l(p.brava);
+	p.skup->ObrisiElement(k);
+	p.broj.store(p.skup->BrojElemenata(), memory_order_relaxed);
+
+	return *this;
+}
+
+// kao UmetniElemente - serija se deli po particijama koje se obradjuju paralelno
+ParticionisaniSkup & ParticionisaniSkup::ObrisiElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(BRISANJE_SERIJE);
+	vector<vector<int>> delovi(particije.size());
+	for (int i = 0; i < broj; i++)
+		delovi[particijaZa(niz[i])].push_back(niz[i]);
+
+	auto obrisi = [&](int i)
+	{
+		if (delovi[i].empty())
+			return;
+
+		Particija& p = *particije[i];
+		lock_guard<mutex> l(p.brava);
+		p.skup->ObrisiElemente(delovi[i].data(), (int)delovi[i].size());
+		p.broj.store(p.skup->BrojElemenata(), memory_order_relaxed);
+	};
+
+	BazenNiti::Zajednicki().Izvrsi((int)particije.size(), obrisi);
+
+	return *this;
+}
+
+// zakljucavaju se samo particije koje opseg dodiruje, jedna po jedna; one koje su cele u opsegu se prazne
+ParticionisaniSkup & ParticionisaniSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
+
+	size_t prva = particijaZa(min), poslednja = particijaZa(max);
+
+	for (size_t i = prva; i <= poslednja; i++)
+	{
+		Particija& p = *particije[i];
+		int gornja = i + 1 == particije.size() ? INT_MAX : najmanjiU(i + 1) - 1;
+		bool cela = (i > prva || min == najmanjiU(i)) && (i < poslednja || max == gornja);
+
+		lock_guard<mutex> l(p.brava);
+		if (cela)
+			p.skup->IsprazniSkup();
+		else
+			p.skup->ObrisiOpsegVrednosti(min, max);
+		p.broj.store(p.skup->BrojElemenata(), memory_order_relaxed);
+	}
+
+	return *this;
+}
+
+int ParticionisaniSkup::BrojElemenata() const
+{
+	int broj = 0;
+	for (const unique_ptr<Particija>& p : particije)
+		broj += p->broj.load(memory_order_relaxed);
+
+	return broj;
+}
+
+void ParticionisaniSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	for (const unique_ptr<Particija>& p : particije)
+	{
+		lock_guard<mutex> l(p->brava);
+		p->skup->IsprazniSkup();
+		p->broj.store(0, memory_order_relaxed);
+	}
+}
+
+int ParticionisaniSkup::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (min > max)
+		throw INDEKS;
+
+	int broj = 0;
+	for (size_t i = particijaZa(min); i <= particijaZa(max); i++)
+	{
+		Particija& p = *particije[i];
+
+		lock_guard<mutex> l(p.brava);
+		broj += p.skup->BrojUOpsegu(min, max);
+	}
+
+	return broj;
+}
+
+ParticionisaniSkup * ParticionisaniSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+// sa skupom iste podele particije se oduzimaju paralelno, svaka od odgovarajuce
+ParticionisaniSkup & ParticionisaniSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	const ParticionisaniSkup* drugi = dynamic_cast<const ParticionisaniSkup*>(&s2);
+	if (drugi == nullptr || !istaPodela(*drugi)) // druga vrsta skupa - spajanje preko kursora
+	{
+		razlikaUMestuKursorima(s2);
+		return *this;
+	}
+
+	auto oduzmi = [&](int i)
+	{
+		Particija& p = *particije[i];
+		*p.skup -= *drugi->particije[i]->skup;
+		p.broj.store(p.skup->BrojElemenata(), memory_order_relaxed);
+	};
+
+	BazenNiti::Zajednicki().Izvrsi((int)particije.size(), oduzmi);
+
+	return *this;
+}
+
+/* sa skupom iste podele svaka particija rezultata je rezultat iste operacije nad
+odgovarajucim particijama; operacije se biraju prema delovima kao u Skup */
+ParticionisaniSkup * ParticionisaniSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	const ParticionisaniSkup* drugi = dynamic_cast<const ParticionisaniSkup*>(&s2);
+	bool poznatiDelovi = delovi == SAMO_PRVI || delovi == OBA || delovi == SVI || delovi == (SAMO_PRVI | SAMO_DRUGI);
+	if (drugi == nullptr || !istaPodela(*drugi) || !poznatiDelovi) // druga vrsta skupa - spajanje preko kursora
+		return static_cast<ParticionisaniSkup*>(spojiKursorima(s2, delovi));
+
+	ParticionisaniSkup* rezultat = new ParticionisaniSkup(vrsta, (int)particije.size());
+
+	auto spoji = [&](int i)
+	{
+		const Skup& a = *particije[i]->skup;
+		const Skup& b = *drugi->particije[i]->skup;
+
+		Skup* deo = delovi == SAMO_PRVI ? a.Razlika(b) : delovi == OBA ? a.Presek(b) : delovi == SVI ? a.Unija(b) : a.SimetricnaRazlika(b);
+
+		rezultat->particije[i]->skup.reset(deo);
+		rezultat->particije[i]->broj = deo->BrojElemenata();
+	};
+
+	BazenNiti::Zajednicki().Izvrsi((int)particije.size(), spoji);
+
+	return rezultat;
+}
+
+bool ParticionisaniSkup::postoji(const Skup & s2, int delovi) const
+{
+	return postojiKursorima(s2, delovi);
+}
+
+void ParticionisaniSkup::preuzmi(Skup * s)
+{
+	*this = move(*static_cast<ParticionisaniSkup*>(s));
+	delete s;
+}
+
+ParticionisaniSkup * ParticionisaniSkup::prazan() const
+{
+	return new ParticionisaniSkup(vrsta, (int)particije.size());
+}
+
+unique_ptr<Skup::Kursor> ParticionisaniSkup::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new Kursor(this));
+}
+
+ParticionisaniSkup::Kursor::Kursor(const ParticionisaniSkup * _skup) :skup(_skup), i(0), tekuci(_skup->particije[0]->skup->NapraviKursor())
+{
+	naVazeci();
+}
+
+// prazne particije i kraj particije se preskacu
+void ParticionisaniSkup::Kursor::naVazeci()
+{
+	while (!tekuci->Vazeci() && ++i < skup->particije.size())
+		tekuci = skup->particije[i]->skup->NapraviKursor();
+}
+
+void ParticionisaniSkup::Kursor::Trazi(int k)
+{
+	if (!Vazeci())
+		return;
+
+	size_t j = skup->particijaZa(k);
+	if (j > i)
+	{
+		i = j;
+		tekuci = skup->particije[i]->skup->NapraviKursor();
+	}
+
+	tekuci->Trazi(k);
+	naVazeci();
+}
+
+uintptr_t ParticionisaniSkup::pozicijaNeManjegOd(int k) const
+{
+	for (size_t i = particijaZa(k); i < particije.size(); i++)
+	{
+		const Skup& s = *particije[i]->skup;
+
+		Skup::Iterator it = s.lower_bound(k);
+		if (it != s.end())
+			return (uintptr_t)uNeoznacen(*it) + 1;
+	}
+
+	return 0;
+}
+
+uintptr_t ParticionisaniSkup::pozicijaKraja() const
+{
+	return 0;
+}
+
+uintptr_t ParticionisaniSkup::sledecaPozicija(uintptr_t p) const
+{
+	int k = kljucNaPoziciji(p);
+
+	return k == INT_MAX ? 0 : pozicijaNeManjegOd(k + 1);
+}
+
+uintptr_t ParticionisaniSkup::prethodnaPozicija(uintptr_t p) const
+{
+	size_t i = p == 0 ? particije.size() - 1 : particijaZa(kljucNaPoziciji(p));
+
+	for (bool prva = p != 0; ; prva = false)
+	{
+		const Skup& s = *particije[i]->skup;
+
+		Skup::Iterator it = prva ? s.lower_bound(kljucNaPoziciji(p)) : s.end();
+		if (it != s.begin())
+			return (uintptr_t)uNeoznacen(*--it) + 1;
+
+		i--; // pre prvog elementa se ne ide, pa particija sa prethodnikom postoji
+	}
+}
+
+int ParticionisaniSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return uOznacen((uint32_t)(p - 1));
+}
+
+#pragma endregion
+
+#pragma region "Snimak.cpp"
+
+uint64_t Snimak::KontrolniZbir(const unsigned char * p, size_t velicina)
+{
+	uint64_t h = 14695981039346656037ull;
+	for (size_t i = 0; i < velicina; i++)
+		if (i < ZAGLAVLJE - 8 || i >= ZAGLAVLJE)
+			h = (h ^ p[i]) * 1099511628211ull;
+
+	return h;
+}
+
+void Snimak::Kodiraj(const Skup & s, vector<unsigned char>& izlaz)
+{
+	vector<unsigned char> direktorijum, podaci;
+	uint32_t broj = 0, prethodni = 0;
+
+	// kursor, a ne iterator, jer je kod stabala bez roditelja korak iteratora O(h)
+	for (unique_ptr<Skup::Kursor> c = s.NapraviKursor(); c->Vazeci(); c->Sledeci())
+	{
+		int k = c->Kljuc();
+		if (broj % KLJUCEVA_U_BLOKU == 0)
+		{
+			size_t d = direktorijum.size();
+			direktorijum.resize(d + STAVKA_DIREKTORIJUMA);
+			Upisi32(&direktorijum[d], (uint32_t)k);
+			Upisi32(&direktorijum[d + 4], (uint32_t)podaci.size());
+		}
+		else
+			UpisiVarint(podaci, (uint32_t)k - prethodni);
+
+		prethodni = (uint32_t)k;
+		broj++;
+	}
+
+	izlaz.assign(ZAGLAVLJE, 0);
+	izlaz.reserve(ZAGLAVLJE + direktorijum.size() + podaci.size());
+	izlaz.insert(izlaz.end(), direktorijum.begin(), direktorijum.end());
+	izlaz.insert(izlaz.end(), podaci.begin(), podaci.end());
+
+	Upisi32(&izlaz[0], OZNAKA);
+	Upisi32(&izlaz[4], VERZIJA);
+	Upisi32(&izlaz[8], broj);
+	Upisi32(&izlaz[12], (uint32_t)(direktorijum.size() / STAVKA_DIREKTORIJUMA));
+	Upisi32(&izlaz[16], KLJUCEVA_U_BLOKU);
+	Upisi32(&izlaz[20], (uint32_t)podaci.size());
+
+	uint64_t zbir = KontrolniZbir(izlaz.data(), izlaz.size());
+	Upisi32(&izlaz[24], (uint32_t)zbir);
+	Upisi32(&izlaz[28], (uint32_t)(zbir >> 32));
+}
+
+Snimak::Zaglavlje Snimak::CitajZaglavlje(const unsigned char * p)
+{
+	if (Citaj32(p) != OZNAKA || Citaj32(p + 4) != VERZIJA)
+		throw Skup::FORMAT;
+
+	Zaglavlje z;
+	z.broj = Citaj32(p + 8);
+	z.blokova = Citaj32(p + 12);
+	z.kljucevaUBloku = Citaj32(p + 16);
+	z.bajtova = Citaj32(p + 20);
+	z.kontrolniZbir = Citaj32(p + 24) | (uint64_t)Citaj32(p + 28) << 32;
+
+	// svaka razlika zauzima od 1 do 5 bajtova
+	if (z.kljucevaUBloku == 0 || z.broj > INT_MAX || z.blokova != ((uint64_t)z.broj + z.kljucevaUBloku - 1) / z.kljucevaUBloku
+		|| z.bajtova < z.broj - z.blokova || z.bajtova > (uint64_t)(z.broj - z.blokova) * 5)
+		throw Skup::FORMAT;
+
+	return z;
+}
+
+Snimak::Zaglavlje Snimak::Proveri(const unsigned char * p, size_t n, bool kontrolniZbir)
+{
+	if (n < ZAGLAVLJE)
+		throw Skup::FORMAT;
+
+	Zaglavlje z = CitajZaglavlje(p);
+	if (n < Velicina(z))
+		throw Skup::FORMAT;
+
+	const unsigned char* d = p + ZAGLAVLJE;
+	for (size_t b = 0; b < z.blokova; b++, d += STAVKA_DIREKTORIJUMA)
+	{
+		uint32_t pomak = Citaj32(d + 4);
+		if (b == 0 ? pomak != 0 : (int)Citaj32(d) <= (int)Citaj32(d - STAVKA_DIREKTORIJUMA) || pomak < Citaj32(d - STAVKA_DIREKTORIJUMA + 4))
+			throw Skup::FORMAT;
+		if (pomak > z.bajtova)
+			throw Skup::FORMAT;
+	}
+
+	if (kontrolniZbir && KontrolniZbir(p, Velicina(z)) != z.kontrolniZbir)
+		throw Skup::FORMAT;
+
+	return z;
+}
+
+void Snimak::Dekodiraj(const unsigned char * p, const Zaglavlje & z, vector<int>& kljucevi)
+{
+	const unsigned char* direktorijum = p + ZAGLAVLJE;
+	const unsigned char* podaci = direktorijum + (size_t)z.blokova * STAVKA_DIREKTORIJUMA;
+
+	kljucevi.clear();
+	kljucevi.reserve(z.broj);
+
+	for (size_t b = 0; b < z.blokova; b++)
+	{
+		const unsigned char* d = direktorijum + b * STAVKA_DIREKTORIJUMA;
+		const unsigned char* q = podaci + Citaj32(d + 4);
+		const unsigned char* kraj = podaci + (b + 1 < z.blokova ? Citaj32(d + 4 + STAVKA_DIREKTORIJUMA) : z.bajtova);
+
+		int64_t k = (int)Citaj32(d);
+		if (!kljucevi.empty() && k <= kljucevi.back())
+			throw Skup::FORMAT;
+		kljucevi.push_back((int)k);
+
+		size_t uBloku = min<size_t>(z.kljucevaUBloku, z.broj - b * z.kljucevaUBloku);
+		for (size_t i = 1; i < uBloku; i++)
+		{
+			uint32_t razlika;
+			q = CitajVarint(q, kraj, razlika);
+			if (q == nullptr || razlika == 0 || k + razlika > INT_MAX)
+				throw Skup::FORMAT;
+
+			k += razlika;
+			kljucevi.push_back((int)k);
+		}
+
+		if (q != kraj)
+			throw Skup::FORMAT;
+	}
+}
+
+#pragma endregion
+
+#pragma region "MapiraniSkup.cpp"
+
+MapiraniSkup::MapiraniSkup(const string & datoteka, bool proveriZbir) :snimak(nullptr), velicina(0)
+{
+	mapiraj(datoteka);
+
+	try
+	{
+		zaglavlje = Snimak::Proveri(snimak, velicina, proveriZbir);
+	}
+	catch (...)
+	{
+		odmapiraj();
+		throw;
+	}
+
+	direktorijum = snimak + Snimak::ZAGLAVLJE;
+	podaci = direktorijum + (size_t)zaglavlje.blokova * Snimak::STAVKA_DIREKTORIJUMA;
+}
+
+void MapiraniSkup::mapiraj(const string & datoteka)
+{
+#if defined(__unix__) || defined(__APPLE__)
+	int fd = open(datoteka.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw FORMAT;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < Snimak::ZAGLAVLJE)
+	{
+		close(fd);
+		throw FORMAT;
+	}
+
+	// mapiranje ostaje vazece i posle zatvaranja datoteke
+	void* m = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (m == MAP_FAILED)
+		throw FORMAT;
+
+	snimak = static_cast<const unsigned char*>(m);
+	velicina = (size_t)st.st_size;
+#else
+	ifstream fajl(datoteka, ios::binary);
+	if (!fajl.is_open())
+		throw FORMAT;
+
+	bafer.assign(istreambuf_iterator<char>(fajl), istreambuf_iterator<char>());
+	snimak = bafer.data();
+	velicina = bafer.size();
+#endif
+}
+
+void MapiraniSkup::odmapiraj()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	if (snimak != nullptr)
+		munmap(const_cast<unsigned char*>(snimak), velicina);
+#endif
+
+	snimak = nullptr;
+	velicina = 0;
+	bafer.clear();
+}
+
+long MapiraniSkup::blokZa(int k) const
+{
+	// prvi blok ciji je prvi kljuc veci od k
+	size_t levo = 0, desno = zaglavlje.blokova;
+	while (levo < desno)
+	{
+		size_t sredina = (levo + desno) / 2;
+		BROJI_POSETU(1);
+		if (prviU(sredina) <= k)
+			levo = sredina + 1;
+		else
+			desno = sredina;
+	}
+
+	return (long)levo - 1;
+}
+
+bool MapiraniSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	long b = blokZa(k);
+	if (b < 0)
+		return false;
+
+	CitacBloka c = citacBloka(b);
+	while ((int)c.kljuc < k && c.Sledeci())
+		BROJI_POREDJENJA(1);
+
+	return (int)c.kljuc == k;
+}
+
+int MapiraniSkup::brojNeVecihOd(int k) const
+{
+	long b = blokZa(k);
+	if (b < 0)
+		return 0;
+
+	// svi blokovi pre poslednjeg su puni
+	int broj = (int)(b * zaglavlje.kljucevaUBloku) + 1;
+	CitacBloka c = citacBloka(b);
+	while (c.Sledeci() && (int)c.kljuc <= k)
+		broj++;
+
+	return broj;
+}
+
+int MapiraniSkup::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (min > max)
+		throw INDEKS;
+
+	return brojNeVecihOd(max) - (min == INT_MIN ? 0 : brojNeVecihOd(min - 1));
+}
+
+MapiraniSkup & MapiraniSkup::UmetniElement(int)
+{
+	INSTRUMENTISI(UMETANJE);
+	throw SAMO_ZA_CITANJE;
+}
+
+MapiraniSkup & MapiraniSkup::UmetniElemente(const int *, int)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	throw SAMO_ZA_CITANJE;
+}
+
+MapiraniSkup & MapiraniSkup::ObrisiElement(int)
+{
+	INSTRUMENTISI(BRISANJE);
+	throw SAMO_ZA_CITANJE;
+}
+
+MapiraniSkup & MapiraniSkup::ObrisiOpsegVrednosti(int, int)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	throw SAMO_ZA_CITANJE;
+}
+
+void MapiraniSkup::IsprazniSkup()
+{
+	INSTRUMENTISI(PRAZNJENJE);
+	throw SAMO_ZA_CITANJE;
+}
+
+MapiraniSkup & MapiraniSkup::RazlikaUMestu(const Skup &)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	throw SAMO_ZA_CITANJE;
+}
+
+// rezultat spajanja ne moze biti mapiran, pa se pravi kao NizSkup iz sortiranih kljuceva
+Skup * MapiraniSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	return spojiKursorima(s2, delovi);
+}
+
+bool MapiraniSkup::postoji(const Skup & s2, int delovi) const
+{
+	return postojiKursorima(s2, delovi);
+}
+
+void MapiraniSkup::preuzmi(Skup * s)
+{
+	delete s;
+	throw SAMO_ZA_CITANJE;
+}
+
+Skup * MapiraniSkup::prazan() const
+{
+	return new NizSkup();
+}
+
+Skup * MapiraniSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	return spojiSa(s2, SAMO_PRVI);
+}
+
+void MapiraniSkup::pisi(ostream & o) const
+{
+	for (Kursor k(this); k.Vazeci(); k.Sledeci())
+		o << k.Kljuc() << ' ';
+}
+
+unique_ptr<Skup::Kursor> MapiraniSkup::NapraviKursor() const
+{
+	return unique_ptr<Skup::Kursor>(new Kursor(this));
+}
+
+MapiraniSkup::Kursor::Kursor(const MapiraniSkup * _skup) :skup(_skup), blok(0), citac()
+{
+	if (Vazeci())
+		citac = skup->citacBloka(0);
+}
+
+void MapiraniSkup::Kursor::Sledeci()
+{
+	if (!citac.Sledeci() && ++blok < skup->zaglavlje.blokova)
+		citac = skup->citacBloka(blok);
+}
+
+// u dalji blok se skace pretragom direktorijuma
+void MapiraniSkup::Kursor::Trazi(int k)
+{
+	if (!Vazeci() || Kljuc() >= k)
+		return;
+
+	if (blok + 1 < skup->zaglavlje.blokova && skup->prviU(blok + 1) <= k)
+	{
+		blok = skup->blokZa(k);
+		citac = skup->citacBloka(blok);
+	}
+
+	while (Vazeci() && Kljuc() < k)
+		Sledeci();
+}
+
+uintptr_t MapiraniSkup::pozicijaNeManjegOd(int k) const
+{
+	if (zaglavlje.blokova == 0)
+		return 0;
+
+	long b = blokZa(k);
+	if (b < 0)
+		return pozicija(citacBloka(0));
+
+	CitacBloka c = citacBloka(b);
+	while ((int)c.kljuc < k)
+	{
+		if (!c.Sledeci())
+			return b + 1 < (long)zaglavlje.blokova ? pozicija(citacBloka(b + 1)) : 0;
+	}
+
+	return pozicija(c);
+}
+
+uintptr_t MapiraniSkup::pozicijaKraja() const
+{
+	return 0;
+}
+
+uintptr_t MapiraniSkup::sledecaPozicija(uintptr_t p) const
+{
+	int k = kljucNaPoziciji(p);
+	long b = blokZa(k);
+
+	CitacBloka c = { podaci + (size_t)((uint64_t)p >> 32) - 1, podaci + krajBloka(b), (uint32_t)k, granicaBloka(b) };
+	if (c.Sledeci())
+		return pozicija(c);
+
+	return b + 1 < (long)zaglavlje.blokova ? pozicija(citacBloka(b + 1)) : 0;
+}
+
+// prethodnik se nalazi dekodiranjem bloka od pocetka
+uintptr_t MapiraniSkup::prethodnaPozicija(uintptr_t p) const
+{
+	if (p == 0)
+	{
+		CitacBloka c = citacBloka(zaglavlje.blokova - 1);
+		while (c.Sledeci());
+
+		return pozicija(c);
+	}
+
+	int k = kljucNaPoziciji(p);
+	long b = blokZa(k);
+
+	CitacBloka c = citacBloka(b);
+	if ((int)c.kljuc == k)
+	{
+		c = citacBloka(b - 1);
+		while (c.Sledeci());
+
+		return pozicija(c);
+	}
+
+	CitacBloka prethodni = c;
+	while (c.Sledeci() && (int)c.kljuc < k)
+		prethodni = c;
+
+	return pozicija(prethodni);
+}
+
+int MapiraniSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return (int)(uint32_t)p;
+}
+
+#pragma endregion
+
+#pragma region "HashSkup.cpp"
+
+// murmur3 zavrsno mesanje - i nizi i visi biti zavise od svih bita kljuca
+inline uint64_t HashSkup::hes(int k)
+{
+	uint64_t h = (uint32_t)k;
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDull;
+	h ^= h >> 33;
+	h *= 0xC4CEB9FE1A85EC53ull;
+	h ^= h >> 33;
+
+	return h;
+}
+
+inline uint32_t HashSkup::poklapanja(const uint8_t * grupa, uint8_t bajt)
+{
+#if defined(__SSE2__) || defined(_M_X64)
+	__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(grupa));
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8((char)bajt)));
+#else
+	uint32_t m = 0;
+	for (size_t i = 0; i < GRUPA; i++)
+		m |= (uint32_t)(grupa[i] == bajt) << i;
+	return m;
+#endif
+}
+
+inline uint32_t HashSkup::puna(const uint8_t * grupa)
+{
+#if defined(__SSE2__) || defined(_M_X64)
+	return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(grupa)));
+#else
+	uint32_t m = 0;
+	for (size_t i = 0; i < GRUPA; i++)
+		m |= (uint32_t)(grupa[i] >> 7) << i;
+	return m;
+#endif
+}
+
+inline int HashSkup::nulaNaKraju(uint32_t m)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(m);
+#else
+	int b = 0;
+	for (; (m & 1) == 0; m >>= 1)
+		b++;
+	return b;
+#endif
+}
+
+HashSkup::Tabela::Tabela(size_t _grupa) :grupa(_grupa), punih(0), obrisanih(0)
+{
+	if (grupa == 0)
+		return;
+
+	kontrola.reset(static_cast<uint8_t*>(calloc(Kapacitet(), 1)));
+	if (kontrola == nullptr)
+		throw bad_alloc();
+	kljucevi.reset(new int[Kapacitet()]);
+	BROJI_ALOKACIJU();
+}
+
+HashSkup::Tabela::Tabela(const Tabela & t) :Tabela(t.grupa)
+{
+	if (grupa == 0)
+		return;
+
+	memcpy(kontrola.get(), t.kontrola.get(), Kapacitet());
+	memcpy(kljucevi.get(), t.kljucevi.get(), Kapacitet() * sizeof(int));
+	punih = t.punih;
+	obrisanih = t.obrisanih;
+}
+
+// grupe se obilaze trougaonim koracima (1, 2, 3...), sto za stepen dvojke pogadja svaku grupu
+long HashSkup::Tabela::Nadji(int k, uint64_t h) const
+{
+	if (grupa == 0)
+		return -1;
+
+	size_t maska = grupa - 1, g = (size_t)(h >> 7) & maska;
+	uint8_t oznaka = (uint8_t)(h | 0x80);
+
+	for (size_t korak = 1; korak <= grupa; korak++)
+	{
+		const uint8_t* c = kontrola.get() + g * GRUPA;
+		BROJI_POSETU(0);
+		for (uint32_t m = poklapanja(c, oznaka); m != 0; m &= m - 1)
+		{
+			size_t mesto = g * GRUPA + nulaNaKraju(m);
+			BROJI_POREDJENJA(1);
+			if (kljucevi[mesto] == k)
+				return (long)mesto;
+		}
+
+		// prazno mesto znaci da proba nikad nije prosla kroz ovu grupu
+		if (poklapanja(c, PRAZNO) != 0)
+			return -1;
+
+		g = (g + korak) & maska;
+	}
+
+	return -1;
+}
+
+void HashSkup::Tabela::Umetni(int k, uint64_t h)
+{
+	size_t maska = grupa - 1, g = (size_t)(h >> 7) & maska;
+
+	for (size_t korak = 1; ; korak++)
+	{
+		uint32_t m = ~puna(kontrola.get() + g * GRUPA) & 0xFFFF;
+		if (m != 0)
+		{
+			size_t mesto = g * GRUPA + nulaNaKraju(m);
+			if (kontrola[mesto] == OBRISANO)
+				obrisanih--;
+
+			kontrola[mesto] = (uint8_t)(h | 0x80);
+			kljucevi[mesto] = k;
+			punih++;
+			return;
+		}
+
+		g = (g + korak) & maska;
+	}
+}
+
+// mesto u grupi koja ima prazno mesto se prazni, jer kroz takvu grupu nijedna proba nije prosla
+void HashSkup::Tabela::Obrisi(size_t mesto)
+{
+	bool imaPraznog = poklapanja(kontrola.get() + mesto / GRUPA * GRUPA, PRAZNO) != 0;
+
+	kontrola[mesto] = imaPraznog ? PRAZNO : OBRISANO;
+	punih--;
+	if (!imaPraznog)
+		obrisanih++;
+}
+
+HashSkup::HashSkup(HashSkup && s) :tekuca(move(s.tekuca)), stara(move(s.stara)), premesteno(s.premesteno), poredak(move(s.poredak)), uredjen(s.uredjen)
+{
+	s.tekuca = Tabela();
+	s.stara = Tabela();
+	s.premesteno = 0;
+	s.poredak.clear();
+	s.uredjen = true;
+}
+
+HashSkup & HashSkup::operator=(const HashSkup & s)
+{
+	if (this != &s)
+	{
+		HashSkup kopija(s);
+		*this = move(kopija);
+	}
+
+	return *this;
+}
+
+HashSkup & HashSkup::operator=(HashSkup && s)
+{
+	if (this != &s)
+	{
+		tekuca = move(s.tekuca);
+		stara = move(s.stara);
+		premesteno = s.premesteno;
+		poredak = move(s.poredak);
+		uredjen = s.uredjen;
+
+		s.tekuca = Tabela();
+		s.stara = Tabela();
+		s.premesteno = 0;
+		s.poredak.clear();
+		s.uredjen = true;
+	}
+
+	return *this;
+}
+
+// premestena mesta stare tabele se oznacavaju kao obrisana, da probe kroz njih ostanu ispravne
+void HashSkup::premestiKorak()
+{
+	for (size_t i = 0; i < KORAK_PREMESTANJA && premesteno < stara.grupa; i++, premesteno++)
+	{
+		uint8_t* c = stara.kontrola.get() + premesteno * GRUPA;
+		for (uint32_t m = puna(c); m != 0; m &= m - 1)
+		{
+			size_t mesto = premesteno * GRUPA + nulaNaKraju(m);
+			int k = stara.kljucevi[mesto];
+
+			tekuca.Umetni(k, hes(k));
+			c[mesto % GRUPA] = OBRISANO;
+			stara.punih--;
+		}
+	}
+
+	if (premesteno == stara.grupa)
+	{
+		stara = Tabela();
+		premesteno = 0;
+	}
+}
+
+void HashSkup::zavrsiPremestanje()
+{
+	while (stara.grupa != 0)
+		premestiKorak();
+}
+
+/* kada se tekuca popuni, postaje stara, a nova je dvostruko veca - ili iste velicine ako je vecina
+zauzetih mesta obrisana. Stara se premesti pre nego sto se nova popuni, pa premestanje koje je u
+toku ovde gotovo nikad ne mora da se zavrsava odjednom */
+void HashSkup::pripremiUmetanje()
+{
+	if (stara.grupa != 0)
+		premestiKorak();
+
+	if (tekuca.grupa != 0 && !tekuca.Puna())
+		return;
+
+	zavrsiPremestanje();
+
+	size_t grupa = tekuca.grupa == 0 ? 1 : tekuca.punih >= tekuca.Kapacitet() / 16 * 7 ? tekuca.grupa * 2 : tekuca.grupa;
+	stara = move(tekuca);
+	tekuca = Tabela(grupa);
+	premesteno = 0;
+
+	if (stara.punih == 0)
+		stara = Tabela();
+}
+
+bool HashSkup::PostojanjeElementa(int k) const
+{
+	INSTRUMENTISI(POSTOJANJE);
+	uint64_t h = hes(k);
+
+	return tekuca.Nadji(k, h) >= 0 || stara.Nadji(k, h) >= 0;
+}
+
+// hesevi grupe se racunaju unapred i prve grupe kontrolnih bajtova ucitavaju pre poredjenja
+void HashSkup::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	const size_t SERIJA = 16;
+	uint64_t h[SERIJA];
+
+	for (size_t od = 0; od < broj; od += SERIJA)
+	{
+		size_t n = min(SERIJA, broj - od);
+		for (size_t i = 0; i < n && tekuca.grupa != 0; i++)
+		{
+			h[i] = hes(kljucevi[od + i]);
+			size_t mesto = ((size_t)(h[i] >> 7) & (tekuca.grupa - 1)) * GRUPA;
+			predUcitaj(tekuca.kontrola.get() + mesto);
+			predUcitaj(tekuca.kljucevi.get() + mesto);
+		}
+
+		for (size_t i = 0; i < n; i++)
+			rezultat[od + i] = tekuca.grupa != 0 && (tekuca.Nadji(kljucevi[od + i], h[i]) >= 0 || stara.Nadji(kljucevi[od + i], h[i]) >= 0);
+	}
+}
+
+HashSkup & HashSkup::UmetniElement(int k)
+{
+	INSTRUMENTISI(UMETANJE);
+	uint64_t h = hes(k);
+	if (tekuca.Nadji(k, h) >= 0 || stara.Nadji(k, h) >= 0)
+		return *this;
+
+	pripremiUmetanje();
+	tekuca.Umetni(k, h);
+	izmenjen();
+
+	return *this;
+}
+
+HashSkup & HashSkup::ObrisiElement(int k)
+{
+	INSTRUMENTISI(BRISANJE);
+	uint64_t h = hes(k);
+
+	long mesto = tekuca.Nadji(k, h);
+	if (mesto >= 0)
+		tekuca.Obrisi(mesto);
+	else if ((mesto = stara.Nadji(k, h)) >= 0)
+		stara.Obrisi(mesto);
+	else
+		return *this;
+
+	if (stara.grupa != 0)
+		premestiKorak();
+	izmenjen();
+
+	return *this;
 }
 
-#pragma endregion
+/* uzak opseg se brise pretragom svakog kljuca iz njega, a sirok pregledom cele tabele; pretraga
+jednog kljuca kosta otprilike koliko pregled osam mesta */
+HashSkup & HashSkup::ObrisiOpsegVrednosti(int min, int max)
+{
+	INSTRUMENTISI(BRISANJE_OPSEGA);
+	if (min > max)
+		throw INDEKS;
 
-#pragma region "BSTSkup.cpp"
+	uint64_t sirina = (uint64_t)((int64_t)max - min) + 1;
+	if (sirina * 8 < tekuca.Kapacitet() + stara.Kapacitet())
+	{
+		for (int64_t k = min; k <= max; k++)
+			ObrisiElement((int)k);
+		return *this;
+	}
 
-void BSTSkup::kopiraj(const BSTSkup & s)
+	for (Tabela* t : { &tekuca, &stara })
+		for (size_t mesto = 0; mesto < t->Kapacitet(); mesto++)
+			if ((t->kontrola[mesto] & 0x80) != 0 && t->kljucevi[mesto] >= min && t->kljucevi[mesto] <= max)
+				t->Obrisi(mesto);
+
+	izmenjen();
+
+	return *this;
+}
+
+void HashSkup::IsprazniSkup()
 {
-	Cvor* p = s.koren;
-	if (p == nullptr) // nema svrhe kopiranje
-		return;
+	INSTRUMENTISI(PRAZNJENJE);
+	tekuca = Tabela();
+	stara = Tabela();
+	premesteno = 0;
+	vector<int>().swap(poredak);
+	uredjen = true;
+}
 
-	Cvor* noviKoren, *tmp;
+// razlika se racuna prolaskom kroz manji skup i pretragom u vecem
+HashSkup * HashSkup::Razlika(const Skup & s2) const
+{
+	INSTRUMENTISI(RAZLIKA);
+	HashSkup* rezultat;
 
-	Stek<Cvor*> stek1, stek2;
+	if (BrojElemenata() <= s2.BrojElemenata())
+	{
+		rezultat = new HashSkup();
+		zaSvaki([&](int k) { if (!s2.PostojanjeElementa(k)) rezultat->UmetniElement(k); });
+	}
+	else
+	{
+		rezultat = new HashSkup(*this);
+		zaSvakiU(s2, [rezultat](int k) { rezultat->ObrisiElement(k); });
+	}
 
-	// kopiranje korena
-	noviKoren = new Cvor(p->kljuc); // const za rezultat
-	tmp = noviKoren;				// promenljiva za obradu
-	n++;
+	return rezultat;
+}
 
-	stek1.Dodaj(p);
-	stek2.Dodaj(tmp);
+HashSkup & HashSkup::RazlikaUMestu(const Skup & s2)
+{
+	INSTRUMENTISI(RAZLIKA_U_MESTU);
+	if (&s2 == this)
+	{
+		IsprazniSkup();
+		return *this;
+	}
 
-	// preorder kopiranje stabla
-	while (!stek1.Prazan() && !stek2.Prazan())
+	if (s2.BrojElemenata() <= BrojElemenata())
 	{
-		p = stek1.Uzmi();	// originalno stablo
-		tmp = stek2.Uzmi();	// kopirano stablo
+		zaSvakiU(s2, [this](int k) { ObrisiElement(k); });
+		return *this;
+	}
 
-		while (p != nullptr)
+	// kljucevi se prvo izdvajaju jer brisanje pomera premestanje tabela
+	vector<int> zaBrisanje;
+	zaSvaki([&](int k) { if (s2.PostojanjeElementa(k)) zaBrisanje.push_back(k); });
+	for (int k : zaBrisanje)
+		ObrisiElement(k);
+
+	return *this;
+}
+
+// presek i razlika prolaze kroz manji skup, a unija i simetricna razlika dopunjuju kopiju ovog skupa
+Skup * HashSkup::spojiSa(const Skup & s2, int delovi) const
+{
+	if (delovi == SAMO_PRVI)
+		return Razlika(s2);
+
+	if (delovi == OBA)
+	{
+		HashSkup* rezultat = new HashSkup();
+		if (BrojElemenata() <= s2.BrojElemenata())
+			zaSvaki([&](int k) { if (s2.PostojanjeElementa(k)) rezultat->UmetniElement(k); });
+		else
+			zaSvakiU(s2, [&](int k) { if (PostojanjeElementa(k)) rezultat->UmetniElement(k); });
+
+		return rezultat;
+	}
+
+	if (delovi == SVI || delovi == (SAMO_PRVI | SAMO_DRUGI))
+	{
+		HashSkup* rezultat = new HashSkup(*this);
+		bool simetricna = delovi != SVI;
+		zaSvakiU(s2, [&](int k)
 		{
-			if (p->levi != nullptr)	// kopiranje levog podstabla
-			{
-				tmp->levi = new Cvor(p->levi->kljuc);
-				n++;
-			}
-			if (p->desni != nullptr) // kopiranje desnog podstabla
-			{
-				tmp->desni = new Cvor(p->desni->kljuc);
-				n++;
-			}
+			if (simetricna && PostojanjeElementa(k))
+				rezultat->ObrisiElement(k);
+			else
+				rezultat->UmetniElement(k);
+		});
 
-			if (p->desni != nullptr) // dodavanje na stek desnog cvora
-			{
-				stek1.Dodaj(p->desni);
-				stek2.Dodaj(tmp->desni);
-			}
+		return rezultat;
+	}
 
-			// skretanje ulevo
-			p = p->levi;
-			tmp = tmp->levi;
-		}
+	return spojiKursorima(s2, delovi);
+}
+
+bool HashSkup::postoji(const Skup & s2, int delovi) const
+{
+	// obilazak staje na prvom kljucu koji nije u s2 (SAMO_PRVI), odnosno koji jeste (OBA)
+	if (delovi == SAMO_PRVI)
+		return !zaSvakiDok([&](int k) { return s2.PostojanjeElementa(k); });
+
+	if (delovi == OBA)
+	{
+		if (BrojElemenata() <= s2.BrojElemenata())
+			return !zaSvakiDok([&](int k) { return !s2.PostojanjeElementa(k); });
+		else
+			return !zaSvakiUDok(s2, [this](int k) { return !PostojanjeElementa(k); });
 	}
 
-	koren = noviKoren;
+	return postojiKursorima(s2, delovi);
 }
 
-void BSTSkup::premesti(BSTSkup & s)
+void HashSkup::preuzmi(Skup * s)
 {
-	koren = s.koren;
-	n = s.n;
+	*this = move(*static_cast<HashSkup*>(s));
+	delete s;
+}
 
-	s.koren = nullptr;
-	s.n = 0;
+HashSkup * HashSkup::prazan() const
+{
+	return new HashSkup();
 }
 
-// postorder brisanje stabla
-void BSTSkup::obrisi()
+int HashSkup::kvantil(int i, int delova) const
 {
-	// niz posecenih cvorova; svaki cvor kada se prvi put poseti stavi se da bude false, 
-	// a drugi put (kada treba da bude obrisan) njegov par u nizu posecenih jeste false
-	bool *poseceni = new bool[n];
-	int i = 0;
+	urediPoredak();
 
-	/* stek cvorova sluzi za pamcenje cvorova, dok stek indeksa je stek na koji
-	se dodaje i uzima u isto vreme kada se to radi i u prvom steku i prestavlja
-	mesto za cuvanje indeksa niza posecenog cvorova (jer c jezici ne podrzavaju
-	negaciju pokazivaca)	*/
-	Stek<Cvor*> stek;
-	Stek<int> stekIndeksa;
+	return poredak[poredak.size() * i / delova];
+}
 
-	Cvor* tmp = koren;
+void HashSkup::urediPoredak() const
+{
+	if (uredjen)
+		return;
 
-	// navigacija u levu stranu
-	while (tmp != nullptr)
-	{
-		stek.Dodaj(tmp);
-		stekIndeksa.Dodaj(i);
-		poseceni[i++] = false;
+	poredak.clear();
+	poredak.reserve(BrojElemenata());
+	zaSvaki([this](int k) { poredak.push_back(k); });
+	sort(poredak.begin(), poredak.end());
 
-		tmp = tmp->levi;
-	}
+	uredjen = true;
+}
+
+void HashSkup::pisi(ostream & o) const
+{
+	urediPoredak();
+
+	for (int k : poredak)
+		o << k << ' ';
+}
+
+unique_ptr<Skup::Kursor> HashSkup::NapraviKursor() const
+{
+	urediPoredak();
+
+	return unique_ptr<Skup::Kursor>(new Kursor(poredak));
+}
+
+uintptr_t HashSkup::pozicijaNeManjegOd(int k) const
+{
+	urediPoredak();
+
+	return JezgraNiza::Izabrana().NeManjiOd(poredak.data(), poredak.size(), k);
+}
+
+uintptr_t HashSkup::pozicijaKraja() const
+{
+	urediPoredak();
+
+	return poredak.size();
+}
+
+uintptr_t HashSkup::sledecaPozicija(uintptr_t p) const
+{
+	return p + 1;
+}
+
+uintptr_t HashSkup::prethodnaPozicija(uintptr_t p) const
+{
+	return p - 1;
+}
+
+int HashSkup::kljucNaPoziciji(uintptr_t p) const
+{
+	return poredak[p];
+}
+
+// uzak opseg se broji pretragom svakog kljuca, a sirok u sortiranoj kopiji
+int HashSkup::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (min > max)
+		throw INDEKS;
 
-	while (!stek.Prazan())
+	uint64_t sirina = (uint64_t)((int64_t)max - min) + 1;
+	if (!uredjen && sirina * 8 < tekuca.Kapacitet() + stara.Kapacitet())
 	{
-		// uzimanje sa steka
-		tmp = stek.Uzmi();
-		int pTabela = stekIndeksa.Uzmi();
-		i--;
+		int broj = 0;
+		for (int64_t k = min; k <= max; k++)
+			broj += PostojanjeElementa((int)k);
+		return broj;
+	}
 
-		if (poseceni[pTabela] == false) // prva poseta
-		{
-			// dodavanje na stek drugi put
-			stek.Dodaj(tmp);
-			stekIndeksa.Dodaj(i);
-			poseceni[i++] = true;
+	urediPoredak();
+	const JezgraNiza& j = JezgraNiza::Izabrana();
+	size_t od = j.NeManjiOd(poredak.data(), poredak.size(), min);
+	size_t doo = max == INT_MAX ? poredak.size() : j.NeManjiOd(poredak.data(), poredak.size(), max + 1);
 
-			// navigacija u desnog sina
-			tmp = tmp->desni;
+	return (int)(doo - od);
+}
 
-			// navigacija i dodavanje na levo
-			while (tmp != nullptr)
-			{
-				stek.Dodaj(tmp);
-				stekIndeksa.Dodaj(i);
-				poseceni[i++] = false;
+#pragma endregion
 
-				tmp = tmp->levi;
-			}
-		}
-		else // druga poseta
-			delete tmp;
+#pragma region "FabrikaSkupova.cpp"
+
+Skup * FabrikaSkupova::Napravi(int vrsta)
+{
+	switch (vrsta)
+	{
+	case DCLL: return new DCLLSkup();
+	case BST: return new BSTSkup();
+	case AVL: return new AVLSkup();
+	case NIZ: return new NizSkup();
+	case BITMAPA: return new BitmapSkup();
+	case DCLL_INDEKS: return new DCLLSkup(true);
+	case BST_RANG: return new BSTSkup(true);
+	case KONKURENTNI: return new KonkurentniSkup();
+	case PARTICIONISANI: return new ParticionisaniSkup(AVL);
+	case HASH: return new HashSkup();
+	case BPLUS: return new BPlusSkup<>();
+	default: return nullptr;
 	}
+}
 
-	koren = nullptr;
-	n = 0;
-	delete poseceni;
+const char * FabrikaSkupova::Opis(int vrsta)
+{
+	switch (vrsta)
+	{
+	case DCLL: return "skup predstavljen dvostruko ulancanom listom";
+	case BST: return "skup predstavljen binarnim stablom pretrazivanja";
+	case AVL: return "skup predstavljen AVL stablom (samobalansirajuce)";
+	case NIZ: return "skup predstavljen sortiranim nizom";
+	case BITMAPA: return "skup predstavljen kompresovanom bitmapom";
+	case DCLL_INDEKS: return "skup predstavljen dvostruko ulancanom listom sa indeksom (skip lista)";
+	case BST_RANG: return "skup predstavljen binarnim stablom pretrazivanja sa velicinama podstabala (rang i izbor)";
+	case KONKURENTNI: return "skup predstavljen konkurentnom skip listom (bezbedan za vise niti)";
+	case PARTICIONISANI: return "skup podeljen po opsezima kljuceva na AVL stabla sa zasebnim bravama (bezbedan za vise niti)";
+	case HASH: return "skup predstavljen hes tabelom sa otvorenim adresiranjem (neuredjen)";
+	case BPLUS: return "skup predstavljen B+ stablom sa sirokim cvorovima i povezanim listovima";
+	default: return "";
+	}
 }
 
-BSTSkup::Cvor * BSTSkup::pronadiElement(int k, Cvor* koren) const
+const char * FabrikaSkupova::Naziv(int vrsta)
 {
-	Cvor* tmp = koren;
+	switch (vrsta)
+	{
+	case DCLL: return "dcll";
+	case BST: return "bst";
+	case AVL: return "avl";
+	case NIZ: return "niz";
+	case BITMAPA: return "bitmapa";
+	case DCLL_INDEKS: return "dcll_indeks";
+	case BST_RANG: return "bst_rang";
+	case KONKURENTNI: return "konkurentni";
+	case PARTICIONISANI: return "particionisani";
+	case HASH: return "hash";
+	case BPLUS: return "bplus";
+	default: return "";
+	}
+}
 
-	// pretrazivanje
-	while (tmp != nullptr)
+int FabrikaSkupova::PoNazivu(const string & naziv)
+{
+	for (int vrsta = 1; vrsta <= BrojVrsta(); vrsta++)
+		if (naziv == Naziv(vrsta) || naziv == to_string(vrsta))
+			return vrsta;
+
+	return 0;
+}
+
+#pragma endregion
+
+#pragma region "BazenNiti.cpp"
+
+BazenNiti::BazenNiti(int brojRadnika) :posao(nullptr), poslova(0), sledeci(0), zavrseno(0), aktivnih(0), serija(0), gasenje(false)
+{
+	for (int i = 0; i < brojRadnika; i++)
+		radnici.emplace_back(&BazenNiti::radi, this);
+}
+
+BazenNiti::~BazenNiti()
+{
 	{
-		// skretanje u levo i desno podstablo
-		if (k == tmp->kljuc) // element je pronaden
-			return tmp;
-		else if (k < tmp->kljuc)
-			tmp = tmp->levi;
-		else
-			tmp = tmp->desni;
+		lock_guard<mutex> l(brava);
+		gasenje = true;
 	}
+	novaSerija.notify_all();
 
-	return nullptr;
+	for (thread& t : radnici)
+		t.join();
 }
 
-void BSTSkup::pisi(ostream & o) const
+BazenNiti & BazenNiti::Zajednicki()
 {
-	Stek<Cvor*> stek;
-	Cvor* tmp = koren;
+	static BazenNiti bazen(max(1, (int)thread::hardware_concurrency()) - 1);
+	return bazen;
+}
 
-	while (1)
+void BazenNiti::obradi(const function<void(int)>& f, int broj)
+{
+	for (int i = sledeci.fetch_add(1); i < broj; i = sledeci.fetch_add(1))
 	{
-		while (tmp)
+		// izuzetak ne sme da napusti radnika (terminate), a posao se i tada broji kao zavrsen
+		exception_ptr e;
+		try
 		{
-			stek.Dodaj(tmp);
-			tmp = tmp->levi;
+			f(i);
 		}
-
-		if (!stek.Prazan())
+		catch (...)
 		{
-			tmp = stek.Uzmi();
-			o << tmp->kljuc << ' ';
-			tmp = tmp->desni;
+			e = current_exception();
 		}
-		else
-			break;
+
+		lock_guard<mutex> l(brava);
+		if (e != nullptr && greska == nullptr)
+			greska = e;
+		if (++zavrseno == broj)
+			krajSerije.notify_all();
 	}
 }
 
-BSTSkup & BSTSkup::operator=(const BSTSkup & s)
+// radnik se prijavljuje na seriju pod bravom, pa serija ne moze da se zavrsi dok on jos uzima poslove
+void BazenNiti::radi()
 {
-	if (this != &s) { obrisi(); kopiraj(s); }
+	long long poslednja = 0;
 
-	return *this;
-}
+	while (true)
+	{
+		const function<void(int)>* f;
+		int broj;
+		{
+			unique_lock<mutex> l(brava);
+			novaSerija.wait(l, [&]() { return gasenje || serija != poslednja; });
+			if (gasenje)
+				return;
+
+			poslednja = serija;
+			f = posao;
+			broj = poslova;
+			aktivnih++;
+		}
 
-BSTSkup & BSTSkup::operator=(BSTSkup && s)
-{
-	if (this != &s) { obrisi(); premesti(s); }
+		if (f != nullptr) // serija je zavrsena pre nego sto se radnik probudio
+			obradi(*f, broj);
 
-	return *this;
+		lock_guard<mutex> l(brava);
+		if (--aktivnih == 0)
+			krajSerije.notify_all();
+	}
 }
 
-bool BSTSkup::PostojanjeElementa(int k) const
+void BazenNiti::Izvrsi(int broj, const function<void(int)>& f)
 {
-	return pronadiElement(k, koren) != nullptr;
-}
+	if (broj <= 0)
+		return;
 
-BSTSkup & BSTSkup::UmetniElement(int k)
-{
-	Cvor* p = koren;   // trenutni
-	Cvor* q = nullptr; // prethodni cvor
+	lock_guard<mutex> jedna(izvrsavanje);
 
-					   // pretraga i pamcenje prethodnog cvora
-	while (p != nullptr)
+	/* radnik koji se prijavio na prethodnu seriju posle njenog kraja jos moze da uzima indekse,
+	pa se nova serija objavljuje tek kada se svi odjave */
 	{
-		q = p;
+		unique_lock<mutex> l(brava);
+		krajSerije.wait(l, [&]() { return aktivnih == 0; });
+
+		posao = &f;
+		poslova = broj;
+		sledeci = 0;
+		zavrseno = 0;
+		greska = nullptr;
+		serija++;
+	}
+	novaSerija.notify_all();
 
-		// skretanje u levo i desno podstablo
-		if (k < p->kljuc)
-			p = p->levi;
-		else if (k > p->kljuc)
-			p = p->desni;
-		else // element je vec u skupu
-			return *this;
+	obradi(f, broj);
+
+	exception_ptr e;
+	{
+		unique_lock<mutex> l(brava);
+		krajSerije.wait(l, [&]() { return zavrseno == broj && aktivnih == 0; });
+
+		// f prestaje da postoji po povratku
+		posao = nullptr;
+		poslova = 0;
+		swap(e, greska);
 	}
 
-	Cvor* novi = new Cvor(k);
+	if (e != nullptr)
+		rethrow_exception(e);
+}
 
-	// pakovanje novog cvora na prethodnik
-	if (q == nullptr) // slucaj da je stablo prazno
-		koren = novi;
-	else
-		if (k < q->kljuc)
-			q->levi = novi;
-		else
-			q->desni = novi;
+#pragma endregion
 
-	// brojac broja elemenata
-	n++;
+#pragma region "Skup.cpp"
+
+Skup & Skup::operator+=(int k)
+{
+	return UmetniElement(k);
+}
+
+Skup & Skup::UmetniElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	for (int i = 0; i < broj; i++)
+		UmetniElement(niz[i]);
 
 	return *this;
 }
 
-BSTSkup & BSTSkup::ObrisiElement(int k)
+Skup & Skup::operator-=(int k)
 {
-	Cvor* p = koren;   // trenutni
-	Cvor* q = nullptr; // prethodni
+	return ObrisiElement(k);
+}
 
-					   // pretrazivanje na zadati kljuc i pamcenje prethodnika
-	while (p != nullptr && p->kljuc != k)
+void Skup::PostojanjeElemenata(const int * kljucevi, size_t broj, bool * rezultat) const
+{
+	INSTRUMENTISI(POSTOJANJE_SERIJE);
+	if (broj < (size_t)INT_MAX && pojedinacno((int)broj, BrojElemenata()))
 	{
-		q = p;
+		for (size_t i = 0; i < broj; i++)
+			rezultat[i] = PostojanjeElementa(kljucevi[i]);
+		return;
+	}
 
-		// skretanje u levo i desno podstablo
-		if (k < p->kljuc)
-			p = p->levi;
-		else
-			p = p->desni;
+	// kljuc (neoznacen, zbog poretka) u visih 32 bita, a mesto u seriji u nizih
+	vector<uint64_t> redosled(broj);
+	for (size_t i = 0; i < broj; i++)
+		redosled[i] = (uint64_t)uNeoznacen(kljucevi[i]) << 32 | i;
+	sort(redosled.begin(), redosled.end());
+
+	unique_ptr<Kursor> c = NapraviKursor();
+	for (uint64_t r : redosled)
+	{
+		int k = kljucevi[(uint32_t)r];
+		c->Trazi(k);
+		rezultat[(uint32_t)r] = c->Vazeci() && c->Kljuc() == k;
 	}
+}
 
-	if (p == nullptr) // element za brisanje ne postoji u skupu
+Skup & Skup::ObrisiElemente(const int * niz, int broj)
+{
+	INSTRUMENTISI(BRISANJE_SERIJE);
+	if (broj <= 0)
 		return *this;
 
-	Cvor* rp = nullptr; // posto se p brise, rp je cvor koji je sin od p
+	NizSkup serija;
+	serija.UmetniElemente(niz, broj);
 
-	if (p->levi == nullptr) // levi sin p ne postoji, rp je desni ako postoji
-		rp = p->desni;
-	else if (p->desni == nullptr) // desni sin p ne postoji, rp je levi jer postoji
-		rp = p->levi;
-	else // p ima i levog i desnog sina
-	{
-		Cvor* f = nullptr, *s = nullptr;
+	return RazlikaUMestu(serija);
+}
 
-		f = p;
-		rp = f->desni;
-		s = rp->levi;
+Skup & Skup::UmetniElementeParalelno(const int * niz, int broj)
+{
+	INSTRUMENTISI(UMETANJE_SERIJE);
+	vector<int> kljucevi(niz, niz + max(broj, 0));
+	sortirajParalelno(kljucevi);
 
-		while (s != nullptr)
-		{
-			f = rp;
-			rp = s;
-			s = rp->levi;
-		}
+	// sortiranu seriju UmetniElemente ne sortira ponovo
+	return UmetniElemente(kljucevi.data(), (int)kljucevi.size());
+}
 
-		if (f != p)
-		{
-			f->levi = rp->desni;
-			rp->desni = p->desni;
-		}
+void Skup::sortirajParalelno(vector<int>& kljucevi)
+{
+	BazenNiti& bazen = BazenNiti::Zajednicki();
+	int delova = bazen.BrojNiti();
 
-		rp->levi = p->levi;
+	if (delova == 1 || kljucevi.size() < MIN_PARALELNO)
+	{
+		sort(kljucevi.begin(), kljucevi.end());
+		return;
 	}
 
-	if (q == nullptr) // prethodnik ne postoji
-		koren = rp;
-	else if (p == q->levi) // p je bio levi sin oca
-		q->levi = rp;
-	else if (p == q->desni) // p je bio desni sin oca
-		q->desni = rp;
+	vector<size_t> granice(delova + 1);
+	for (int d = 0; d <= delova; d++)
+		granice[d] = kljucevi.size() * d / delova;
 
-	delete p;
+	bazen.Izvrsi(delova, [&](int d) { sort(kljucevi.begin() + granice[d], kljucevi.begin() + granice[d + 1]); });
 
-	// brojac elemenata
-	n--;
+	// u svakom krugu se susedni parovi sortiranih delova spajaju u dvostruko duze
+	int korak;
+	auto spojiPar = [&](int par)
+	{
+		int levi = par * 2 * korak;
+		int sredina = min(levi + korak, delova), desni = min(levi + 2 * korak, delova);
 
-	return *this;
+		if (sredina < desni)
+			inplace_merge(kljucevi.begin() + granice[levi], kljucevi.begin() + granice[sredina], kljucevi.begin() + granice[desni]);
+	};
+
+	for (korak = 1; korak < delova; korak *= 2)
+		bazen.Izvrsi((delova + 2 * korak - 1) / (2 * korak), spojiPar);
 }
 
-BSTSkup & BSTSkup::ObrisiOpsegVrednosti(int min, int max)
+int Skup::kvantil(int i, int delova) const
 {
-	if (min > max)
-		throw INDEKS;
-
-	for (int i = min; i <= max; i++)
-		ObrisiElement(i);
+	int prvi = *begin(), poslednji = *--end();
 
-	return *this;
+	return (int)(prvi + ((int64_t)poslednji - prvi) * i / delova);
 }
 
-void BSTSkup::IsprazniSkup()
+Skup * Skup::RazlikaParalelno(const Skup & s2) const
 {
-	obrisi();
-	koren = nullptr;
-	n = 0;
-}
+	INSTRUMENTISI(RAZLIKA);
+	BazenNiti& bazen = BazenNiti::Zajednicki();
+	if (bazen.BrojNiti() == 1 || BrojElemenata() < MIN_PARALELNO)
+		return Razlika(s2);
+
+	// vise delova nego niti ujednacava opterecenje kada kljucevi nisu ravnomerno rasporedjeni
+	int delova = bazen.BrojNiti() * 4;
+	vector<int64_t> granice(delova + 1);
+	granice[0] = INT64_MIN;
+	granice[delova] = INT64_MAX;
+	for (int d = 1; d < delova; d++)
+		granice[d] = kvantil(d, delova);
+
+	// kursor kome se opseg zavrsava pred granicom sledeceg dela
+	struct OgranicenKursor
+	{
+		Kursor& kursor;
+		int64_t granica;
 
-BSTSkup * BSTSkup::Razlika(const Skup & s2) const
-{
-	BSTSkup* rezultat = new BSTSkup();
+		bool Vazeci() const { return kursor.Vazeci() && kursor.Kljuc() < granica; }
+		int Kljuc() const { return kursor.Kljuc(); }
+		void Sledeci() { kursor.Sledeci(); }
+		void Trazi(int k) { kursor.Trazi(k); }
+	};
 
-	Stek<Cvor*> stek1, stek2;
+	// prvo pravljenje kursora moze da izmeni skup (NizSkup spaja seriju na cekanju), pa se radi pre niti
+	NapraviKursor();
+	s2.NapraviKursor();
 
-	try
+	vector<vector<int>> delovi(delova);
+	auto spojiDeo = [&](int d)
 	{
-		Cvor* p1 = koren;
-		Cvor* p2 = (dynamic_cast<const BSTSkup&>(s2)).koren;
+		if (granice[d] == granice[d + 1])
+			return;
 
-		/* inorder obilazak stabla jer on jedini kod BST daje sortiran
-		redosled cvorova, a procedura je zatim slicna kao liste -
-		poredi se cvor po cvor */
-		while (1)
+		unique_ptr<Kursor> a = NapraviKursor(), b = s2.NapraviKursor();
+		if (d > 0)
 		{
-			while (p1 != nullptr) // dodavanje na stek iz p1 sve do krajnjeg levog cvora
-			{
-				stek1.Dodaj(p1);
-				p1 = p1->levi;
-			}
+			a->Trazi((int)granice[d]);
+			b->Trazi((int)granice[d]);
+		}
 
-			while (p2 != nullptr) // dodavanje na stek iz p2 sve do krajnjeg levog cvora
-			{
-				stek2.Dodaj(p2);
-				p2 = p2->levi;
-			}
+		OgranicenKursor oa = { *a, granice[d + 1] }, ob = { *b, granice[d + 1] };
+		vector<int>& deo = delovi[d];
+		spajanjeKursora(oa, ob, SAMO_PRVI, [&deo](int k) { deo.push_back(k); return true; });
+	};
 
-			if (!stek1.Prazan() && !stek2.Prazan())
-			{
-				if (stek1.Vrh()->kljuc < stek2.Vrh()->kljuc) // info(p1) < info(p2) - dodavanje elementa
-				{
-					p1 = stek1.Uzmi();
-					rezultat->operator+=(p1->kljuc);
+	bazen.Izvrsi(delova, spojiDeo);
 
-					p1 = p1->desni;
-				}
-				else if (stek1.Vrh()->kljuc == stek2.Vrh()->kljuc) // ima u oba - pomeranje na sledbenik
-				{
-					p1 = stek1.Uzmi();
-					p2 = stek2.Uzmi();
+	size_t ukupno = 0;
+	for (const vector<int>& deo : delovi)
+		ukupno += deo.size();
 
-					p1 = p1->desni;
-					p2 = p2->desni;
-				}
-				else
-				{
-					p2 = stek2.Uzmi();
+	vector<int> kljucevi;
+	kljucevi.reserve(ukupno);
+	for (const vector<int>& deo : delovi)
+		kljucevi.insert(kljucevi.end(), deo.begin(), deo.end());
 
-					p2 = p2->desni;
-				}
-			}
-			else
-				break;
-		}
+	Skup* rezultat = prazan();
+	rezultat->UmetniElemente(kljucevi.data(), (int)kljucevi.size());
 
-		// ispisivanje onoga sto je ostalo u steku br. 1 jer to spada u razliku skupova i to sa inorder 
-		while (1)
-		{
-			while (p1 != nullptr) // dodavanje na stek iz p1 sve do krajnjeg levog cvora
-			{
-				stek1.Dodaj(p1);
-				p1 = p1->levi;
-			}
+	return rezultat;
+}
 
-			if (!stek1.Prazan())
-			{
-				p1 = stek1.Uzmi();
-				rezultat->operator+=(p1->kljuc);
+// kursorom od prvog kljuca opsega - korak kursora stabla je amortizovano O(1), a iteratora O(h); vrste koje mogu brze (npr. NizSkup) ovo zamenjuju
+int Skup::BrojUOpsegu(int min, int max) const
+{
+	INSTRUMENTISI(BROJ_U_OPSEGU);
+	if (min > max)
+		throw INDEKS;
 
-				p1 = p1->desni;
-			}
-			else
-				break;
-		}
+	unique_ptr<Kursor> kursor = NapraviKursor();
+	kursor->Trazi(min);
 
-	}
-	catch (const std::bad_cast&)
-	{
-		throw TIP;
-	}
+	int broj = 0;
+	for (; kursor->Vazeci() && kursor->Kljuc() <= max; kursor->Sledeci())
+		broj++;
 
-	return rezultat;
+	return broj;
 }
 
-#pragma endregion
-
-#pragma region "DCLLSkup.cpp"
-
-void DCLLSkup::kopiraj(const DCLLSkup & ss)
+Skup * Skup::spojiKursorima(const Skup & s2, int delovi) const
 {
-	pZaglavlje = new Zaglavlje(0, nullptr, nullptr);
+	unique_ptr<Kursor> a = NapraviKursor(), b = s2.NapraviKursor();
 
-	Element *original = ss.pZaglavlje->sledeci;
-	Element *prethodni = pZaglavlje;
-	Element *trenutni = nullptr;
+	vector<int> kljucevi;
+	spajanjeKursora(*a, *b, delovi, [&kljucevi](int k) { kljucevi.push_back(k); return true; });
 
-	// dodavanje elementa po element uz pamcenje zadnjeg pokazivaca
-	while (original != ss.pZaglavlje)
-	{
-		trenutni = new Element(original->broj);
+	// kljucevi su sortirani, pa vrste koje to podrzavaju grade rezultat u O(n)
+	Skup* rezultat = prazan();
+	rezultat->UmetniElemente(kljucevi.data(), (int)kljucevi.size());
 
-		trenutni->prethodni = prethodni;
-		prethodni->sledeci = trenutni;
+	return rezultat;
+}
 
-		prethodni = trenutni;
-		original = original->sledeci;
+bool Skup::postojiKursorima(const Skup & s2, int delovi) const
+{
+	unique_ptr<Kursor> a = NapraviKursor(), b = s2.NapraviKursor();
 
-		azurirajZaglavlje(DODAVANJE);
-	}
+	bool nadjen = false;
+	spajanjeKursora(*a, *b, delovi, [&nadjen](int) { nadjen = true; return false; });
 
-	if (trenutni != nullptr) // zadnji element pokazuje na zaglavlje i obrnuto
+	return nadjen;
+}
+
+// zajednicki kljucevi se nalaze pretragom kao kod preseka; malo ih se brise pojedinacno, a inace se preuzima razlika
+void Skup::razlikaUMestuKursorima(const Skup & s2)
+{
+	vector<int> zajednicki;
 	{
-		trenutni->sledeci = pZaglavlje;
-		pZaglavlje->prethodni = trenutni;
+		unique_ptr<Kursor> a = NapraviKursor(), b = s2.NapraviKursor();
+		spajanjeKursora(*a, *b, OBA, [&zajednicki](int k) { zajednicki.push_back(k); return true; });
 	}
-	else // zaglavlje pokazuje samo na sebe jer nema elemenata
+
+	if (zajednicki.empty())
+		return;
+
+	if (pojedinacno((int)zajednicki.size(), BrojElemenata()))
 	{
-		pZaglavlje->sledeci = pZaglavlje;
-		pZaglavlje->prethodni = pZaglavlje;
+		for (int k : zajednicki)
+			ObrisiElement(k);
 	}
+	else
+		preuzmi(spojiKursorima(s2, SAMO_PRVI));
 }
 
-void DCLLSkup::premesti(DCLLSkup & s)
+bool Skup::pojedinacno(int m, int n)
 {
-	pZaglavlje = s.pZaglavlje;
-	s.pZaglavlje = nullptr;
+	int logn = 1;
+	for (int x = n; x > 1; x >>= 1)
+		logn++;
+
+	return (long long)m * logn < n;
 }
 
-void DCLLSkup::obrisi()
+void Skup::pripremiSeriju(vector<int>& kljucevi)
 {
-	Element* t = pZaglavlje->sledeci;
+	if (!is_sorted(kljucevi.begin(), kljucevi.end()))
+		sort(kljucevi.begin(), kljucevi.end());
 
-	while (t != pZaglavlje)
-	{
-		Element* sledeci = t->sledeci;
-		delete t;
-		t = sledeci;
-	}
+	kljucevi.erase(unique(kljucevi.begin(), kljucevi.end()), kljucevi.end());
+}
 
-	delete pZaglavlje;
+Skup * operator-(const Skup & s1, const Skup & s2)
+{
+	return s1.Razlika(s2);
 }
 
-inline void DCLLSkup::inicijalizuj()
+Skup * operator&(const Skup & s1, const Skup & s2)
 {
-	// formiranje zaglavlja ulancane liste sa brojem 0 kao brojem clanova skupa
-	pZaglavlje = new Zaglavlje(0, nullptr, nullptr);
-	pZaglavlje->sledeci = pZaglavlje;
-	pZaglavlje->prethodni = pZaglavlje;
+	return s1.Presek(s2);
 }
 
-inline void DCLLSkup::azurirajZaglavlje(Operacija op)
+Skup * operator|(const Skup & s1, const Skup & s2)
 {
-	// azuriranje broja elemenata u zaglavlju
-	if (op == DODAVANJE)
-		pZaglavlje->broj++;
-	else
-		pZaglavlje->broj--;
+	return s1.Unija(s2);
 }
 
-inline void DCLLSkup::dodajNakon(Element * p, int k)
+Skup * operator^(const Skup & s1, const Skup & s2)
 {
-	Element* novi = new Element(k);
-	Element* sledeci = p->sledeci;
+	return s1.SimetricnaRazlika(s2);
+}
 
-	novi->prethodni = p;
-	novi->sledeci = sledeci;
+Skup & Skup::operator&=(const Skup & s2)
+{
+	preuzmi(Presek(s2));
+	return *this;
+}
 
-	p->sledeci = novi;
-	sledeci->prethodni = novi;
+Skup & Skup::operator|=(const Skup & s2)
+{
+	preuzmi(Unija(s2));
+	return *this;
+}
 
-	azurirajZaglavlje(DODAVANJE);
+Skup & Skup::operator^=(const Skup & s2)
+{
+	preuzmi(SimetricnaRazlika(s2));
+	return *this;
 }
 
-inline void DCLLSkup::dodajPre(Element * p, int k)
+Skup & Skup::operator-=(const Skup & s2)
 {
-	Element* novi = new Element(k);
-	Element* prethodni = p->prethodni;
+	return RazlikaUMestu(s2);
+}
 
-	novi->prethodni = prethodni;
-	novi->sledeci = p;
+// skup koji ima vise elemenata ne moze biti podskup, pa se spajanje i ne pokrece
+bool Skup::JePodskupOd(const Skup & s2) const
+{
+	INSTRUMENTISI(PODSKUP);
+	if (BrojElemenata() > s2.BrojElemenata())
+		return false;
 
-	p->prethodni = novi;
-	prethodni->sledeci = novi;
+	return !postoji(s2, SAMO_PRVI);
+}
 
-	azurirajZaglavlje(DODAVANJE);
+bool Skup::ImaPresek(const Skup & s2) const
+{
+	INSTRUMENTISI(IMA_PRESEK);
+	return postoji(s2, OBA);
 }
 
-void DCLLSkup::pisi(ostream & o) const
+ostream & operator<<(ostream & o, const Skup & s)
 {
-	Element* tmp = pZaglavlje->sledeci;
+	s.pisi(o);
+	return o;
+}
 
-	while (tmp != pZaglavlje)
+void Skup::Sacuvaj(ostream & o) const
+{
+	INSTRUMENTISI(CUVANJE);
+	vector<unsigned char> snimak;
+	Snimak::Kodiraj(*this, snimak);
+
+	o.write(reinterpret_cast<const char*>(snimak.data()), snimak.size());
+}
+
+// snimak se cita u delovima, pa skraceni snimak sa neispravnim zaglavljem ne zauzima memoriju za ceo
+Skup & Skup::Ucitaj(istream & i)
+{
+	INSTRUMENTISI(UCITAVANJE);
+	vector<unsigned char> snimak(Snimak::ZAGLAVLJE);
+	if (!i.read(reinterpret_cast<char*>(snimak.data()), Snimak::ZAGLAVLJE))
+		throw FORMAT;
+
+	size_t velicina = Snimak::Velicina(Snimak::CitajZaglavlje(snimak.data()));
+	while (snimak.size() < velicina)
 	{
-		o << tmp->broj << ' ';
-		tmp = tmp->sledeci;
+		size_t procitano = snimak.size();
+		snimak.resize(min(velicina, procitano + (1 << 20)));
+
+		if (!i.read(reinterpret_cast<char*>(snimak.data() + procitano), snimak.size() - procitano))
+			throw FORMAT;
 	}
+
+	vector<int> kljucevi;
+	Snimak::Dekodiraj(snimak.data(), Snimak::Proveri(snimak.data(), snimak.size(), true), kljucevi);
+
+	IsprazniSkup();
+	UmetniElemente(kljucevi.data(), (int)kljucevi.size());
+
+	return *this;
 }
 
-DCLLSkup & DCLLSkup::operator=(const DCLLSkup & s)
+Instrumentacija::Izvestaj Skup::Merenja() const
 {
-	if (this != &s) { obrisi(); kopiraj(s); }
+#ifdef INSTRUMENTACIJA
+	return instrumentacija.Stanje();
+#else
+	return Instrumentacija::Izvestaj();
+#endif
+}
 
-	return *this;
+void Skup::PonistiMerenja()
+{
+#ifdef INSTRUMENTACIJA
+	instrumentacija.Ponisti();
+#endif
 }
 
-DCLLSkup & DCLLSkup::operator=(DCLLSkup && s)
+#pragma endregion
+
+#pragma region "IzvrsilacOpterecenja.cpp"
+
+const char * IzvrsilacOpterecenja::Naziv(Tip tip)
 {
-	if (this != &s) { obrisi(); premesti(s); }
+	switch (tip)
+	{
+	case UMETANJE: return "umetanje";
+	case BRISANJE: return "brisanje";
+	case BRISANJE_OPSEGA: return "brisanje_opsega";
+	case PRETRAGA: return "pretraga";
+	case RAZLIKA: return "razlika";
+	case PRAZNJENJE: return "praznjenje";
+	default: return "";
+	}
+}
 
-	return *this;
+/* format reda: '<operacija> [argumenti]', prazni redovi i redovi koji pocinju sa # se preskacu
+   umetni | insert k
+   obrisi | delete k
+   obrisi_opseg | range-delete min max
+   trazi | lookup k
+   razlika | difference k1 k2 ... (razlika sa skupom iste vrste sa zadatim elementima)
+   isprazni | clear */
+bool IzvrsilacOpterecenja::Ucitaj(istream & ulaz, vector<Operacija>& operacije, string & greska)
+{
+	string red;
+	int brojReda = 0;
+
+	while (getline(ulaz, red))
+	{
+		brojReda++;
+
+		istringstream ss(red);
+		string naredba;
+		if (!(ss >> naredba) || naredba[0] == '#')
+			continue;
+
+		Tip tip;
+		int a = 0, b = 0;
+		vector<int> kljucevi;
+		bool ispravno;
+
+		if (naredba == "umetni" || naredba == "insert")
+		{
+			tip = UMETANJE;
+			ispravno = (bool)(ss >> a);
+		}
+		else if (naredba == "obrisi" || naredba == "delete")
+		{
+			tip = BRISANJE;
+			ispravno = (bool)(ss >> a);
+		}
+		else if (naredba == "obrisi_opseg" || naredba == "range-delete")
+		{
+			tip = BRISANJE_OPSEGA;
+			ispravno = (ss >> a >> b) && a <= b;
+		}
+		else if (naredba == "trazi" || naredba == "lookup")
+		{
+			tip = PRETRAGA;
+			ispravno = (bool)(ss >> a);
+		}
+		else if (naredba == "razlika" || naredba == "difference")
+		{
+			tip = RAZLIKA;
+			while (ss >> a)
+				kljucevi.push_back(a);
+			ispravno = ss.eof();
+		}
+		else
+		{
+			tip = PRAZNJENJE;
+			ispravno = naredba == "isprazni" || naredba == "clear";
+		}
+
+		if (!ispravno)
+		{
+			greska = "neispravan red " + to_string(brojReda) + ": " + red;
+			return false;
+		}
+
+		operacije.emplace_back(tip, a, b);
+		operacije.back().kljucevi.swap(kljucevi);
+	}
+
+	return true;
 }
 
-bool DCLLSkup::PostojanjeElementa(int k) const
+void IzvrsilacOpterecenja::Izvrsi(int vrsta, const vector<Operacija>& operacije, int ponavljanja, ostream & izvestaj, Format format, ostream* merenja, const string& snimak)
 {
-	if (pZaglavlje->broj == 0) // skup je prazan, nema svrhe da se pretrazuje
-		return false;
-	else
+	vector<double> kasnjenja[BROJ_TIPOVA]; // mikrosekunde
+	double ukupno[BROJ_TIPOVA] = {};
+	long long pogodaka = 0;
+
+	bool mapiran = vrsta == 0;
+	const char* naziv = mapiran ? "mapirani" : FabrikaSkupova::Naziv(vrsta);
+	int vrstaDrugog = mapiran ? FabrikaSkupova::NIZ : vrsta;
+
+	// snimak se cita jednom, a ne pri svakom ponavljanju
+	string sadrzaj;
+	if (!snimak.empty() && !mapiran)
+	{
+		ifstream fajl(snimak, ios::binary);
+		if (!fajl.is_open())
+			throw Skup::FORMAT;
+		sadrzaj.assign(istreambuf_iterator<char>(fajl), istreambuf_iterator<char>());
+	}
+
+	PerformanceCalculator pc;
+	unique_ptr<Skup> s(mapiran ? new MapiraniSkup(snimak) : FabrikaSkupova::Napravi(vrsta));
+	Skup* skup = s.get();
+
+	for (int p = 0; p < ponavljanja; p++)
 	{
-		Element* el = pZaglavlje->sledeci;
+		// svako ponavljanje krece od praznog skupa ili od snimka
+		if (!snimak.empty() && !mapiran)
+		{
+			istringstream ulaz(sadrzaj);
+			skup->Ucitaj(ulaz);
+		}
+		else if (!mapiran)
+			skup->IsprazniSkup();
 
-		while (el != pZaglavlje)
+		for (const Operacija& op : operacije)
 		{
-			if (el->broj == k)
-				return true;
+			Skup* drugi = nullptr;
+			Skup* rezultat = nullptr;
 
-			el = el->sledeci;
-		}
+			if (op.tip == RAZLIKA) // formiranje drugog skupa ne ulazi u merenje
+			{
+				drugi = FabrikaSkupova::Napravi(vrstaDrugog);
+				for (int k : op.kljucevi)
+					drugi->UmetniElement(k);
+			}
 
-		return false;
-	}
-}
+			pc.start();
+			switch (op.tip)
+			{
+			case UMETANJE: skup->UmetniElement(op.a); break;
+			case BRISANJE: skup->ObrisiElement(op.a); break;
+			case BRISANJE_OPSEGA: skup->ObrisiOpsegVrednosti(op.a, op.b); break;
+			case PRETRAGA: pogodaka += skup->PostojanjeElementa(op.a); break;
+			case RAZLIKA: rezultat = *skup - *drugi; break;
+			default: skup->IsprazniSkup(); break;
+			}
+			pc.stop();
 
-DCLLSkup & DCLLSkup::UmetniElement(int k)
-{
-	Element* trenutni = pZaglavlje;
+			delete rezultat;
+			delete drugi;
+
+			double t = pc.elapsedMillis();
+			kasnjenja[op.tip].push_back(t * 1000);
+			ukupno[op.tip] += t;
+		}
+	}
 
-	// prvi slucaj je slucaj da je lista prazna
-	if (trenutni->sledeci == pZaglavlje)
-		dodajNakon(trenutni, k);
+	if (format == CSV)
+		izvestaj << "skup,operacija,broj,ops_u_sekundi,prosek_us,medijana_us,p99_us,max_us" << endl;
+	else if (format == JSON)
+		izvestaj << "[";
 	else
-	{
-		// prelazak na prvi element
-		trenutni = trenutni->sledeci;
+		izvestaj << "Skup: " << naziv << ", ponavljanja: " << ponavljanja
+		<< ", elemenata na kraju: " << skup->BrojElemenata() << ", pogodaka u pretrazi: " << pogodaka << endl;
 
-		// pretrazivanje na element 'k'
-		while (trenutni != pZaglavlje && trenutni->broj < k)
-			trenutni = trenutni->sledeci;
+	bool prvi = true;
+	for (int t = 0; t < BROJ_TIPOVA; t++)
+	{
+		if (kasnjenja[t].empty())
+			continue;
+
+		size_t broj = kasnjenja[t].size();
+		double max = *max_element(kasnjenja[t].begin(), kasnjenja[t].end());
+		double propusnost = ukupno[t] > 0 ? broj / (ukupno[t] / 1000) : 0;
+		StatistikaMerenja st = AnalizatorPerformansi::Statistika(kasnjenja[t], vector<long long>()); // jedinica su mikrosekunde
+
+		if (format == CSV)
+			izvestaj << naziv << ',' << Naziv((Tip)t) << ',' << broj << ',' << propusnost << ','
+			<< st.prosek << ',' << st.medijana << ',' << st.p99 << ',' << max << endl;
+		else if (format == JSON)
+			izvestaj << (prvi ? "" : ",") << endl << "  {\"skup\": \"" << naziv << "\", \"operacija\": \"" << Naziv((Tip)t)
+			<< "\", \"broj\": " << broj << ", \"ops_u_sekundi\": " << propusnost << ", \"prosek_us\": " << st.prosek
+			<< ", \"medijana_us\": " << st.medijana << ", \"p99_us\": " << st.p99 << ", \"max_us\": " << max << "}";
+		else
+			izvestaj << "  " << Naziv((Tip)t) << ": " << broj << " operacija, " << propusnost << " ops/s, prosek " << st.prosek
+			<< " us, medijana " << st.medijana << " us, p99 " << st.p99 << " us, max " << max << " us" << endl;
 
-		// ako postoji nista, u suprotnom dodavanje
-		if (trenutni->broj != k)
-			// provera da sledeci cvor nije zaglavlje cije je polje za broj elemenata jednako 'k'
-			if (trenutni->sledeci == pZaglavlje || trenutni->sledeci->broj != k)
-				dodajPre(trenutni, k);
+		prvi = false;
 	}
 
-	return *this;
+	if (format == JSON)
+		izvestaj << endl << "]" << endl;
+
+	if (merenja != nullptr)
+		skup->Merenja().Ispisi(*merenja, format == JSON ? Instrumentacija::JSON : Instrumentacija::TEKST);
 }
 
-DCLLSkup & DCLLSkup::ObrisiElement(int k)
+void IzvrsilacOpterecenja::uputstvo(ostream & o)
 {
-	Element *trenutni = pZaglavlje->sledeci;
+	o << "Upotreba:" << endl;
+	o << "  dz --skup <vrsta> --opterecenje <datoteka> [--snimak <datoteka>] [--ponavljanja N] [--format tekst|csv|json] [--izlaz <datoteka>] [--merenja <datoteka>]" << endl;
+	o << "  dz --mapiraj <snimak> --opterecenje <datoteka> [--ponavljanja N] [--format tekst|csv|json] [--izlaz <datoteka>] [--merenja <datoteka>]" << endl;
+	o << "  dz --analiza --velicina N [--skup <vrsta>]... [--zagrevanje W] [--ponavljanja N] [--ciklusi rdtsc|perf] [--jezgra skalarna|sse4|avx2] [--format csv|json] [--izlaz <datoteka>]" << endl;
+	o << "  dz --analiza --velicina N --niti N [--skup <vrsta>]... [--trajanje ms] [--format csv|json] [--izlaz <datoteka>]" << endl;
+	o << "Vrste skupova:";
+	for (int vrsta = 1; vrsta <= FabrikaSkupova::BrojVrsta(); vrsta++)
+		o << ' ' << FabrikaSkupova::Naziv(vrsta);
+	o << endl;
+}
 
-	// nebrisanje zaglavlja
-	if (trenutni != pZaglavlje)
+int IzvrsilacOpterecenja::KomandnaLinija(int argc, char * argv[])
+{
+	vector<int> vrste;
+	string opterecenje, izlaz, merenja, snimak, mapiraj, format = "tekst";
+	int ponavljanja = 1, zagrevanje = 0, velicina = 0, niti = 0, trajanje = 200;
+	bool analiza = false;
+	PerformanceCalculator::Brojac brojac = PerformanceCalculator::BEZ_CIKLUSA;
+
+	for (int i = 1; i < argc; i++)
 	{
-		while (trenutni != pZaglavlje && trenutni->broj < k)
-			trenutni = trenutni->sledeci;
+		string arg = argv[i];
+		bool imaVrednost = i + 1 < argc;
 
-		if (trenutni != pZaglavlje && trenutni->broj == k)
+		if (arg == "--analiza")
+			analiza = true;
+		else if (arg == "--pomoc" || arg == "--help")
 		{
-			Element* tmp = trenutni;
-
-			// prespojavanje
-			trenutni->prethodni->sledeci = trenutni->sledeci;
-			trenutni->sledeci->prethodni = trenutni->prethodni;
+			uputstvo(cout);
+			return 0;
+		}
+		else if (!imaVrednost)
+		{
+			cerr << "Nedostaje vrednost za " << arg << endl;
+			uputstvo(cerr);
+			return 1;
+		}
+		else if (arg == "--skup")
+		{
+			int vrsta = FabrikaSkupova::PoNazivu(argv[++i]);
+			if (vrsta == 0)
+			{
+				cerr << "Nepoznata vrsta skupa: " << argv[i] << endl;
+				uputstvo(cerr);
+				return 1;
+			}
+			vrste.push_back(vrsta);
+		}
+		else if (arg == "--opterecenje")
+			opterecenje = argv[++i];
+		else if (arg == "--izlaz")
+			izlaz = argv[++i];
+		else if (arg == "--merenja")
+			merenja = argv[++i];
+		else if (arg == "--snimak")
+			snimak = argv[++i];
+		else if (arg == "--mapiraj")
+			mapiraj = argv[++i];
+		else if (arg == "--format")
+			format = argv[++i];
+		else if (arg == "--ponavljanja")
+			ponavljanja = atoi(argv[++i]);
+		else if (arg == "--zagrevanje")
+			zagrevanje = atoi(argv[++i]);
+		else if (arg == "--velicina")
+			velicina = atoi(argv[++i]);
+		else if (arg == "--niti")
+			niti = atoi(argv[++i]);
+		else if (arg == "--trajanje")
+			trajanje = atoi(argv[++i]);
+		else if (arg == "--jezgra")
+		{
+			const JezgraNiza* j = JezgraNiza::PoNazivu(argv[++i]);
+			if (j == nullptr)
+			{
+				cerr << "Jezgra " << argv[i] << " ne postoji ili je procesor ne podrzava" << endl;
+				return 1;
+			}
+			JezgraNiza::Izaberi(*j);
+		}
+		else if (arg == "--ciklusi")
+		{
+			string c = argv[++i];
+			brojac = c == "rdtsc" ? PerformanceCalculator::RDTSC : c == "perf" ? PerformanceCalculator::PERF_EVENT : PerformanceCalculator::BEZ_CIKLUSA;
+		}
+		else
+		{
+			cerr << "Nepoznata opcija: " << arg << endl;
+			uputstvo(cerr);
+			return 1;
+		}
+	}
 
-			azurirajZaglavlje(BRISANJE);
+	if (ponavljanja <= 0 || zagrevanje < 0 || niti < 0 || trajanje <= 0 || (format != "tekst" && format != "csv" && format != "json"))
+	{
+		uputstvo(cerr);
+		return 1;
+	}
 
-			delete tmp;
+	ofstream fajl;
+	if (!izlaz.empty())
+	{
+		fajl.open(izlaz);
+		if (!fajl.is_open())
+		{
+			cerr << "Greska pri otvaranju fajla " << izlaz << endl;
+			return 2;
 		}
 	}
+	ostream& o = izlaz.empty() ? cout : fajl;
 
-	return *this;
-}
+	if (analiza)
+	{
+		if (velicina <= 0)
+		{
+			uputstvo(cerr);
+			return 1;
+		}
 
-DCLLSkup & DCLLSkup::ObrisiOpsegVrednosti(int min, int max)
-{
-	if (min > max)
-		throw INDEKS;
+		AnalizatorPerformansi::konfiguracija.zagrevanje = zagrevanje;
+		AnalizatorPerformansi::konfiguracija.ponavljanja = ponavljanja;
+		AnalizatorPerformansi::konfiguracija.brojac = brojac;
+		AnalizatorPerformansi::konfiguracija.trajanjeMs = trajanje;
 
-	Element* tmp = pZaglavlje->sledeci;
-	int i = min;
+		if (niti > 0)
+		{
+			AnalizatorPerformansi::PokreniVisenitno(o, format == "json" ? AnalizatorPerformansi::JSON : AnalizatorPerformansi::CSV, velicina, (int)time(NULL), niti, vrste);
+			return 0;
+		}
+
+		AnalizatorPerformansi::PokreniSve(o, format == "json" ? AnalizatorPerformansi::JSON : AnalizatorPerformansi::CSV, velicina, (int)time(NULL), vrste);
+		return 0;
+	}
 
-	while (tmp != pZaglavlje && i >= min && i <= max)
+	// mapirani snimak zamenjuje i vrstu skupa i pocetni snimak
+	if ((mapiraj.empty() ? vrste.size() != 1 : !vrste.empty() || !snimak.empty()) || opterecenje.empty())
 	{
-		if (tmp->broj == i)
-		{
-			// brisanje
-			Element* trenutni = tmp;
+		uputstvo(cerr);
+		return 1;
+	}
 
-			// prespajanje
-			trenutni->prethodni->sledeci = trenutni->sledeci;
-			trenutni->sledeci->prethodni = trenutni->prethodni;
+	ifstream ulaz(opterecenje);
+	if (!ulaz.is_open())
+	{
+		cerr << "Greska pri citanju fajla " << opterecenje << endl;
+		return 2;
+	}
 
-			azurirajZaglavlje(BRISANJE);
+	vector<Operacija> operacije;
+	string greska;
+	if (!Ucitaj(ulaz, operacije, greska))
+	{
+		cerr << greska << endl;
+		return 2;
+	}
 
-			tmp = tmp->sledeci;
-			i++;
+	if (!mapiraj.empty())
+		for (const Operacija& op : operacije)
+			if (op.tip != PRETRAGA && op.tip != RAZLIKA)
+			{
+				cerr << "Mapiran snimak je samo za citanje - opterecenje sme da sadrzi samo pretrage i razlike" << endl;
+				return 1;
+			}
 
-			delete trenutni;
+	ofstream fajlMerenja;
+	if (!merenja.empty())
+	{
+#ifndef INSTRUMENTACIJA
+		cerr << "Program nije preveden sa -DINSTRUMENTACIJA - merenja ce biti prazna" << endl;
+#endif
+		fajlMerenja.open(merenja);
+		if (!fajlMerenja.is_open())
+		{
+			cerr << "Greska pri otvaranju fajla " << merenja << endl;
+			return 2;
 		}
-		else if (tmp->broj > i) // i ne postoji
-			i++;
-		else // tmp->broj < i   // premotavanje
-			tmp = tmp->sledeci;
 	}
 
-	return *this;
-}
+	try
+	{
+		Izvrsi(mapiraj.empty() ? vrste[0] : 0, operacije, ponavljanja, o, format == "csv" ? CSV : format == "json" ? JSON : TEKST,
+			merenja.empty() ? nullptr : &fajlMerenja, mapiraj.empty() ? snimak : mapiraj);
+	}
+	catch (Skup::Greska)
+	{
+		cerr << "Greska pri citanju snimka " << (mapiraj.empty() ? snimak : mapiraj) << endl;
+		return 2;
+	}
 
-int DCLLSkup::BrojElemenata() const
-{
-	return pZaglavlje->broj;
+	return 0;
 }
 
-void DCLLSkup::IsprazniSkup()
-{
-	obrisi();
-	inicijalizuj();
-}
+#pragma endregion
 
-DCLLSkup* DCLLSkup::Razlika(const Skup & s2) const
+#pragma region "UvozKljuceva.cpp"
+
+bool UvozKljuceva::Ucitaj(const string & datoteka, vector<int>& kljucevi, string & greska)
 {
-	DCLLSkup* rezultat = new DCLLSkup();
+	FILE* fajl = fopen(datoteka.c_str(), "rb");
+	if (fajl == nullptr)
+	{
+		greska = "datoteka se ne moze otvoriti";
+		return false;
+	}
 
-	Element* p1 = pZaglavlje->sledeci;
+	vector<char> bafer(MAKS_BROJ + VELICINA_BLOKA);
+	size_t prenos = 0;	// zapoceti broj sa kraja prethodnog bloka
+	long long red = 1;
+	bool ispravno = true;
 
-	try
+	while (ispravno)
 	{
-		Element* p2zag = (dynamic_cast<const DCLLSkup&>(s2)).pZaglavlje;
-		Element* p2 = p2zag->sledeci;
+		size_t procitano = fread(bafer.data() + prenos, 1, VELICINA_BLOKA, fajl);
+		bool poslednji = procitano < VELICINA_BLOKA;
+
+		if (poslednji && ferror(fajl))
+		{
+			greska = "greska pri citanju datoteke";
+			ispravno = false;
+			break;
+		}
+
+		const char* p = bafer.data();
+		const char* kraj = p + prenos + procitano;
+
+		// broj presecen krajem bloka se obradjuje zajedno sa sledecim blokom
+		const char* granica = kraj;
+		if (!poslednji)
+			while (granica > p && !belina(granica[-1]))
+				granica--;
 
-		// trazenje sta ima u s1, a nema u s2
-		while (p1 != pZaglavlje && p2 != p2zag)
+		while (p < granica)
 		{
-			if (p1->broj < p2->broj)
+			if (belina(*p))
 			{
-				rezultat->operator+=(p1->broj);
-				p1 = p1->sledeci;
+				if (*p == '\n')
+					red++;
+				p++;
+				continue;
 			}
-			else if (p1->broj == p2->broj)
+
+			if (*p == '+' && p + 1 < granica && p[1] >= '0' && p[1] <= '9') // from_chars ne prihvata znak +, a stoi ga je prihvatao
+				p++;
+
+			int k;
+			from_chars_result r = from_chars(p, granica, k);
+
+			if (r.ec == errc::result_out_of_range)
 			{
-				p1 = p1->sledeci;
-				p2 = p2->sledeci;
+				greska = "broj van opsega u redu " + to_string(red);
+				ispravno = false;
+				break;
 			}
-			else // p1->broj > p2->broj
+			if (r.ec != errc() || (r.ptr < granica && !belina(*r.ptr)))
 			{
-				p2 = p2->sledeci;
+				greska = "neispravan broj u redu " + to_string(red);
+				ispravno = false;
+				break;
 			}
+
+			kljucevi.push_back(k);
+			p = r.ptr;
 		}
 
-		// kopiranje ostatka u p1 skupu jer i to cini razliku
-		while (p1 != pZaglavlje)
+		if (!ispravno || poslednji)
+			break;
+
+		prenos = kraj - granica;
+		if (prenos > MAKS_BROJ)
 		{
-			rezultat->operator+=(p1->broj);
-			p1 = p1->sledeci;
+			greska = "neispravan broj u redu " + to_string(red);
+			ispravno = false;
+			break;
 		}
-	}
-	catch (const std::bad_cast&)
-	{
-		throw TIP;
+
+		memmove(bafer.data(), granica, prenos);
 	}
 
-	return rezultat;
+	fclose(fajl);
+
+	return ispravno;
 }
 
 #pragma endregion
 
-#pragma region "Skup.cpp"
-
-Skup & Skup::operator+=(int k)
-{
-	return UmetniElement(k);
-}
-
-Skup & Skup::operator-=(int k)
-{
-	return ObrisiElement(k);
-}
+#pragma region "Main.cpp"
 
-Skup * operator-(const Skup & s1, const Skup & s2)
+void ispisiVrsteSkupova()
 {
-	return s1.Razlika(s2);
+	for (int vrsta = 1; vrsta <= FabrikaSkupova::BrojVrsta(); vrsta++)
+		cout << "- Za " << FabrikaSkupova::Opis(vrsta) << " unesite " << vrsta << endl;
 }
 
-ostream & operator<<(ostream & o, const Skup & s)
+int main(int argc, char* argv[])
 {
-	s.pisi(o);
-	return o;
-}
-
-#pragma endregion
-
-#pragma region "Main.cpp"
+	if (argc > 1) // neinteraktivni rad
+		return IzvrsilacOpterecenja::KomandnaLinija(argc, argv);
 
-int main()
-{
 	int seme = (int)time(NULL);
 	Skup* skup = nullptr;
 
 	Skup* korisnickiSkup = nullptr;
 	int vrstaSkupa;
+	bool samoZaCitanje = false; // korisnicki skup je mapiran snimak (MapiraniSkup)
 
 	while (1)
 	{
@@ -1193,6 +11114,9 @@ int main()
 		cout << "9. Ispisivanje skupa" << endl;
 		cout << "10. Razlika skupova" << endl;
 		cout << "--------------------------------" << endl;
+		cout << "11. Uporedna analiza svih skupova (CSV/JSON)" << endl;
+		cout << "12. Merenja operacija skupa (uz -DINSTRUMENTACIJA)" << endl;
+		cout << "--------------------------------" << endl;
 		cout << "0. Kraj rada" << endl;
 		cout << "--------------------------------" << endl << endl;
 
@@ -1201,8 +11125,7 @@ int main()
 
 		if (opcija == 1) // testiranje performansi
 		{
-			cout << "- Za skup predstavljen dvostruko ulancanom listom unesite 1" << endl;
-			cout << "- Za skup predstavljen binarnim stablom pretrazivanja unesite 2" << endl;
+			ispisiVrsteSkupova();
 
 			int vrsta;
 			cin >> vrsta;
@@ -1213,11 +11136,8 @@ int main()
 				skup = nullptr;
 			}
 
-			if (vrsta == 1)
-				skup = new DCLLSkup();
-			else if (vrsta == 2)
-				skup = new BSTSkup();
-			else
+			skup = FabrikaSkupova::Napravi(vrsta);
+			if (skup == nullptr)
 				continue;
 
 			cout << "Unesite velicinu skupa: ";
@@ -1230,6 +11150,10 @@ int main()
 			cout << "Prosecno vreme formiranja skupa je: ";
 			cout << AnalizatorPerformansi::FormirajSkup(*skup, velicina, seme) << " ms" << endl;
 
+			StatistikaAlokacije sa = skup->StatistikaAlokatora();
+			if (sa.alokacija > 0)
+				cout << "Alocirano cvorova: " << sa.alokacija << ", blokova: " << sa.blokova << ", zauzeto bajtova: " << sa.bajtova << endl;
+
 			while (1)
 			{
 				cout << "Izaberite operaciju koju zelite da analizirate: " << endl;
@@ -1298,12 +11222,7 @@ int main()
 				}
 				else if (operacija == 5) // razlika
 				{
-					Skup* s2 = nullptr;
-
-					if (vrsta == 1)
-						s2 = new DCLLSkup();
-					else
-						s2 = new BSTSkup();
+					Skup* s2 = FabrikaSkupova::Napravi(vrsta);
 
 					cout << "Vreme odredivanja preseka razlike je: " << endl;
 					cout << AnalizatorPerformansi::Razlika(*skup, *s2, velicina) << " ms" << endl;
@@ -1320,8 +11239,7 @@ int main()
 		}
 		else if (opcija == 2) // formiranje skupa
 		{
-			cout << "- Za skup predstavljen dvostruko ulancanom listom unesite 1" << endl;
-			cout << "- Za skup predstavljen binarnim stablom pretrazivanja unesite 2" << endl;
+			ispisiVrsteSkupova();
 			cout << "* Unosom bilo koje druge vrednosti ce skup biti obrisan" << endl;
 			cin >> vrstaSkupa;
 
@@ -1331,20 +11249,12 @@ int main()
 				korisnickiSkup = nullptr;
 			}
 
-			if (vrstaSkupa == 1)
-			{
-				korisnickiSkup = new DCLLSkup();
-				cout << "Skup je napravljen." << endl;
-			}
-			else if (vrstaSkupa == 2)
-			{
-				korisnickiSkup = new BSTSkup();
+			korisnickiSkup = FabrikaSkupova::Napravi(vrstaSkupa);
+			samoZaCitanje = false;
+			if (korisnickiSkup != nullptr)
 				cout << "Skup je napravljen." << endl;
-			}
 			else
-			{
 				continue;
-			}
 		}
 		else if (opcija == 3) // umetanje elemenata
 		{
@@ -1352,11 +11262,15 @@ int main()
 			{
 				cout << "- Za unos elementa sa standardnog ulaza unesite 1" << endl;
 				cout << "- Za uvoz elemenata iz fajla unesite 2" << endl;
+				cout << "- Za ucitavanje binarnog snimka (sadrzaj skupa se zamenjuje) unesite 3" << endl;
+				cout << "- Za otvaranje binarnog snimka samo za citanje (skup se zamenjuje mapiranim) unesite 4" << endl;
 
 				int ulaz;
 				cin >> ulaz;
 
-				if (ulaz == 1) // direktno
+				if (samoZaCitanje && ulaz >= 1 && ulaz <= 3)
+					cout << "Skup je otvoren samo za citanje. Izaberite opciju 2 za novi skup." << endl;
+				else if (ulaz == 1) // direktno
 				{
 					cout << "Unesite element:" << endl;
 					int x;
@@ -1371,38 +11285,60 @@ int main()
 					string datoteka;
 					cin >> datoteka;
 
-					ifstream fajl;
-					fajl.open(datoteka);
-					if (!fajl.is_open())
+					// ucitava se cela datoteka, pa se u skup umece tek ako je ispravna
+					vector<int> kljucevi;
+					string greska;
+					if (!UvozKljuceva::Ucitaj(datoteka, kljucevi, greska))
 					{
-						cout << "Greksa pri citanju fajla." << endl;
+						cout << "Greksa pri uvozu fajla: " << greska << ". Operacija je prekinuta." << endl;
 						continue;
 					}
 
-					bool prekid = false;
-					while (!fajl.eof() && !prekid)
+					korisnickiSkup->UmetniElemente(kljucevi.data(), (int)kljucevi.size());
+
+					cout << "Uspesno umetanje fajla." << endl;
+				}
+				else if (ulaz == 3) // binarni snimak
+				{
+					cout << "Unesite ime datoteke (absolute path): " << endl;
+					string datoteka;
+					cin >> datoteka;
+
+					ifstream fajl(datoteka, ios::binary);
+					if (!fajl.is_open())
 					{
-						try
-						{
-							string red;
-							getline(fajl, red);
-							int broj = stoi(red);
+						cout << "Greksa pri otvaranju fajla." << endl;
+						continue;
+					}
 
-							korisnickiSkup->UmetniElement(broj);
-						}
-						catch (...)
-						{
-							cout << "Greksa pri pretvaranju niske u broj. Operacija je prekinuta." << endl;
-							fajl.close();
-							prekid = true;
-						}
+					try { korisnickiSkup->Ucitaj(fajl); }
+					catch (...)
+					{
+						cout << "Snimak nije ispravan. Operacija je prekinuta." << endl;
+						continue;
 					}
-					if (prekid)
+
+					cout << "Uspesno ucitavanje snimka." << endl;
+				}
+				else if (ulaz == 4) // mapiran snimak
+				{
+					cout << "Unesite ime datoteke (absolute path): " << endl;
+					string datoteka;
+					cin >> datoteka;
+
+					Skup* mapiran;
+					try { mapiran = new MapiraniSkup(datoteka); }
+					catch (...)
+					{
+						cout << "Snimak ne moze da se otvori ili nije ispravan. Operacija je prekinuta." << endl;
 						continue;
+					}
 
-					fajl.close();
+					delete korisnickiSkup;
+					korisnickiSkup = mapiran;
+					samoZaCitanje = true;
 
-					cout << "Uspesno umetanje fajla." << endl;
+					cout << "Snimak je otvoren samo za citanje." << endl;
 				}
 				else
 					continue;
@@ -1412,7 +11348,9 @@ int main()
 		}
 		else if (opcija == 4) // brisanje
 		{
-			if (korisnickiSkup != nullptr)
+			if (samoZaCitanje)
+				cout << "Skup je otvoren samo za citanje. Izaberite opciju 2 za novi skup." << endl;
+			else if (korisnickiSkup != nullptr)
 			{
 				cout << "Unesite element:" << endl;
 				int x;
@@ -1426,7 +11364,9 @@ int main()
 		}
 		else if (opcija == 5) // brisanje opsega
 		{
-			if (korisnickiSkup != nullptr)
+			if (samoZaCitanje)
+				cout << "Skup je otvoren samo za citanje. Izaberite opciju 2 za novi skup." << endl;
+			else if (korisnickiSkup != nullptr)
 			{
 				cout << "Unesite min i max u jednom redu:" << endl;
 				int min, max;
@@ -1470,7 +11410,9 @@ int main()
 		}
 		else if (opcija == 8) // praznjenje
 		{
-			if (korisnickiSkup != nullptr)
+			if (samoZaCitanje)
+				cout << "Skup je otvoren samo za citanje. Izaberite opciju 2 za novi skup." << endl;
+			else if (korisnickiSkup != nullptr)
 			{
 				korisnickiSkup->IsprazniSkup();
 				cout << "Skup je ispraznjen." << endl;
@@ -1484,6 +11426,7 @@ int main()
 			{
 				cout << "- Za ispis elemenata na standardni izlaz unesite 1" << endl;
 				cout << "- Za ispis elemenata u fajla unesite 2" << endl;
+				cout << "- Za cuvanje binarnog snimka u fajl unesite 3" << endl;
 
 				int ulaz;
 				cin >> ulaz;
@@ -1506,17 +11449,37 @@ int main()
 						continue;
 					}
 
-					ostringstream ss;
-					ss << *korisnickiSkup;
-					string zaIspis = ss.str();
-					zaIspis = zaIspis.substr(0, zaIspis.length() - 1);
-					replace(zaIspis.begin(), zaIspis.end(), ' ', '\n');
+					/* po jedan kljuc u redu, direktno iz skupa bez medjukopije; kursor, a ne iterator, jer je
+					korak iteratora stabla bez desnog deteta novi spust od korena, pa bi ispis bio O(n h) */
+					const char* razdvajac = "";
+					for (unique_ptr<Skup::Kursor> kursor = korisnickiSkup->NapraviKursor(); kursor->Vazeci(); kursor->Sledeci())
+					{
+						fajl << razdvajac << kursor->Kljuc();
+						razdvajac = "\n";
+					}
 
-					fajl << zaIspis;
 					fajl.close();
 
 					cout << "Uspesan ispis u fajl." << endl;
 				}
+				else if (ulaz == 3) // binarni snimak
+				{
+					cout << "Unesite ime datoteke (absolute path): " << endl;
+					string datoteka;
+					cin >> datoteka;
+
+					ofstream fajl(datoteka, ios::binary);
+					if (!fajl.is_open())
+					{
+						cout << "Greksa pri otvaranju fajla." << endl;
+						continue;
+					}
+
+					korisnickiSkup->Sacuvaj(fajl);
+					fajl.close();
+
+					cout << "Uspesno cuvanje snimka." << endl;
+				}
 				else
 					continue;
 			}
@@ -1543,10 +11506,7 @@ int main()
 					if (brojElemenata < 1)
 						continue;
 
-					if (vrstaSkupa == 1)
-						zaRazliku = new DCLLSkup();
-					else
-						zaRazliku = new BSTSkup();
+					zaRazliku = FabrikaSkupova::Napravi(vrstaSkupa);
 
 					cout << "Unosite element po element u novom redu: " << endl;
 					for (int i = 0; i < brojElemenata; i++)
@@ -1558,45 +11518,20 @@ int main()
 				}
 				else if (ulaz == 2)
 				{
-					if (vrstaSkupa == 1)
-						zaRazliku = new DCLLSkup();
-					else
-						zaRazliku = new BSTSkup();
-
 					cout << "Unesite ime datoteke (absolute path): " << endl;
 					string datoteka;
 					cin >> datoteka;
 
-					ifstream fajl;
-					fajl.open(datoteka);
-					if (!fajl.is_open())
+					vector<int> kljucevi;
+					string greska;
+					if (!UvozKljuceva::Ucitaj(datoteka, kljucevi, greska))
 					{
-						cout << "Greksa pri citanju fajla." << endl;
+						cout << "Greksa pri uvozu fajla: " << greska << ". Operacija je prekinuta." << endl;
 						continue;
 					}
 
-					bool prekid = false;
-					while (!fajl.eof() && !prekid)
-					{
-						try
-						{
-							string red;
-							getline(fajl, red);
-							int broj = stoi(red);
-
-							zaRazliku->UmetniElement(broj);
-						}
-						catch (...)
-						{
-							cout << "Greksa pri pretvaranju niske u broj. Operacija je prekinuta." << endl;
-							fajl.close();
-							prekid = true;
-						}
-					}
-					if (prekid)
-						continue;
-
-					fajl.close();
+					zaRazliku = FabrikaSkupova::Napravi(vrstaSkupa);
+					zaRazliku->UmetniElemente(kljucevi.data(), (int)kljucevi.size());
 				}
 				else
 					continue;
@@ -1611,6 +11546,69 @@ int main()
 			else
 				cout << "Skup nije napravljen. Izaberite opciju 2 najpre." << endl;
 		}
+		else if (opcija == 11) // uporedna analiza
+		{
+			int velicina, format;
+			AnalizatorPerformansi::Konfiguracija& k = AnalizatorPerformansi::konfiguracija;
+
+			cout << "Unesite velicinu skupa: ";
+			cin >> velicina;
+			cout << "Unesite broj merenja za zagrevanje i broj merenja u jednom redu: ";
+			cin >> k.zagrevanje >> k.ponavljanja;
+			cout << "Brojanje ciklusa: 0 - bez, 1 - rdtsc, 2 - perf_event: ";
+			int brojac;
+			cin >> brojac;
+			cout << "Format: 1 - CSV, 2 - JSON: ";
+			cin >> format;
+			cout << "Unesite ime datoteke (absolute path) ili - za standardni izlaz: " << endl;
+			string datoteka;
+			cin >> datoteka;
+
+			if (velicina <= 0 || k.zagrevanje < 0 || k.ponavljanja <= 0)
+			{
+				k = AnalizatorPerformansi::Konfiguracija();
+				continue;
+			}
+
+			k.brojac = brojac == 1 ? PerformanceCalculator::RDTSC : brojac == 2 ? PerformanceCalculator::PERF_EVENT : PerformanceCalculator::BEZ_CIKLUSA;
+			AnalizatorPerformansi::Format f = format == 2 ? AnalizatorPerformansi::JSON : AnalizatorPerformansi::CSV;
+
+			if (datoteka == "-")
+				AnalizatorPerformansi::PokreniSve(cout, f, velicina, seme);
+			else
+			{
+				ofstream fajl(datoteka);
+				if (!fajl.is_open())
+					cout << "Greksa pri otvaranju fajla." << endl;
+				else
+				{
+					AnalizatorPerformansi::PokreniSve(fajl, f, velicina, seme);
+					cout << "Uspesan ispis u fajl." << endl;
+				}
+			}
+
+			// ostale analize koriste podrazumevana podesavanja
+			k = AnalizatorPerformansi::Konfiguracija();
+		}
+		else if (opcija == 12) // merenja
+		{
+			if (korisnickiSkup != nullptr)
+			{
+				cout << "Format: 1 - tekst, 2 - JSON; 0 - ponistavanje merenja: ";
+				int format;
+				cin >> format;
+
+				if (format == 0)
+				{
+					korisnickiSkup->PonistiMerenja();
+					cout << "Merenja su ponistena." << endl;
+				}
+				else
+					korisnickiSkup->Merenja().Ispisi(cout, format == 2 ? Instrumentacija::JSON : Instrumentacija::TEKST);
+			}
+			else
+				cout << "Skup nije napravljen. Izaberite opciju 2 najpre." << endl;
+		}
 		else if (opcija == 0) // izlaz
 		{
 			exit(0);